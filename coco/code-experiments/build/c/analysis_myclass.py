@@ -20,7 +20,18 @@ def process_and_plot(directory, groups, output_directory, output_filename):
 
     for group in groups:
         group_data = None
-        
+
+        # my_results export で集計済みの .npy があり、どのテキストファイルよりも新しければそれを使う (列: x, 平均, 10%, 50%, 90%)
+        # テキストファイルの方が新しい (export 後に実験をやり直した) 場合はテキストファイルから読み込む
+        variant = "U-Lb" if group == "U-L" else group
+        npy_path = os.path.join(directory, f"{variant}.npy")
+        text_paths = [os.path.join(directory, f"{variant}-{i}.txt") for i in range(15)]
+        newest_text = max((os.path.getmtime(p) for p in text_paths if os.path.isfile(p)), default=0)
+        if os.path.isfile(npy_path) and os.path.getmtime(npy_path) >= newest_text:
+            aggregated = np.load(npy_path)
+            data_by_group[group] = (aggregated[:, 0], aggregated[:, 1])
+            continue
+
         # 各グループのファイルを順に読み込む
         for i in range(15):  # 0から14までのファイル
             if group == "U-L":
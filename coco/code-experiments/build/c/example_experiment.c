@@ -4,6 +4,8 @@
  *
  * Set the global parameter BUDGET_MULTIPLIER to suit your needs.
  */
+#define _POSIX_C_SOURCE 200809L
+#define _GNU_SOURCE //pthread_setaffinity_np and the CPU_* macros of the launcher
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -11,49 +13,740 @@
 #include <time.h>
 #include <assert.h>
 #include <float.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
 
 #include "coco.h"
+#include "my_plugin.h"
 
 //BENCHMARKING_SETTING
 #define PROBLEM_CLASS 1 //0:coco, 1:my_class
+#ifndef M_PI
 #define M_PI	3.141592653589793238462643
+#endif
 //EA_SETTINGS
 // #define ALGORITHM 0 //0:de,1:ga
 // #define ENCODING 0 //0:basic encoding[0,l], 1:new encoding[0,1], 2:basic2 encoding[0-0.5,l+0.49999]
 // #define APPROACH 0//if encoding is 0, 0:L, 1:B, if encoding is 1, 0:U-Lf, 1:U-Lm, 2:U-Lb, 3:U-B, if encoding is 2, 0:U2-L, 1:U2-B
 
 //DE
-#define DE_N 100
+#define DE_N 100 //population size of the variants, the configurations of --sweep set their own
 #define DE_CR 0.9
 #define DE_F 0.5
+#define DE_DELTA_CR 0.5 //trials are evaluated incrementally (see de_delta_t) if the CR of the variant is <= DE_DELTA_CR
+#define DE_DELTA_REFRESH 32 //incremental evaluations in a row before an individual is evaluated from scratch
+#define DE_RESTART_DIVERSITY 0.0 //restart the DE once the population has converged to this SD per range (see population_stats_converged), 0 disables
+#define DE_COMPACT_POPULATION 0 //1 stores the integer block of the population of the Lamarckian variants as one byte codes (see de_code_values)
+
+/**
+ * The (encoding, approach) pairs of the DE and their names in the output files. Every pair gets its
+ * own specialized initialization, encoding and generation step (see DE_DEFINE_VARIANT), selected at
+ * runtime through de_variants.
+ */
+#define DE_VARIANTS(X) \
+  X(0, 0, "L") \
+  X(0, 1, "B") \
+  X(1, 0, "U-Lf") \
+  X(1, 1, "U-Lm") \
+  X(1, 2, "U-Lb") \
+  X(1, 3, "U-B") \
+  X(2, 0, "U2-L") \
+  X(2, 1, "U2-B")
+
+#define COUNT_DE_VARIANT(E, A, NAME) + 1
+enum { NUMBER_OF_DE_VARIANTS = 0 DE_VARIANTS(COUNT_DE_VARIANT) };
+
+/* The Lamarckian variants write the rounded integer block back to the individual: L, U-Lf, U-Lm, U-Lb and U2-L. */
+#define DE_LAMARCKIAN(E, A) ((((E) == 0 || (E) == 2) && (A) == 0) || ((E) == 1 && (A) <= 2))
+#define DE_MAX_CODES 256 //values an integer coordinate can take in the compact population
+
+/**
+ * The dimension ladder of init_problem, which is also the one of bbob-mixint. The encoding and
+ * generation steps of the DE and the built-in functions are instantiated with these dimensions as
+ * compile-time trip counts; problems of other dimensions use the generic instantiation.
+ */
+#define FIXED_DIMENSIONS(X, ...) \
+  X(5, __VA_ARGS__) \
+  X(10, __VA_ARGS__) \
+  X(20, __VA_ARGS__) \
+  X(40, __VA_ARGS__) \
+  X(80, __VA_ARGS__) \
+  X(160, __VA_ARGS__)
+
+#define COUNT_FIXED_DIMENSION(D, ...) + 1
+enum { NUMBER_OF_FIXED_DIMENSIONS = 0 FIXED_DIMENSIONS(COUNT_FIXED_DIMENSION, ~) };
+
+#if defined(__GNUC__)
+#define FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define FORCE_INLINE inline
+#endif
 
 //MY_COCO_SETTINGS
-#define NUMBER_OF_PROBLEM 9720
+#define NUMBER_OF_PROBLEM 9720 //built-in problems, plugin problems are appended
 #define NUMBER_OF_TARGET 51
+#define MAX_PLUGINS 16
+#define CATALOG_MAGIC "MYCATLG"
+#define CATALOG_VERSION 1
+#define CATALOG_FUNCTION_NAME_LENGTH 32
+#define TRAJECTORY_RING_SIZE 256 //records per worker ring, a power of two
+#define TRAJECTORY_MAX_RINGS 64
+#define TRAJECTORY_MAX_DIMENSION 160
+#define TRAJECTORY_PATH_LENGTH 160
+#define TRAJECTORY_MAGIC "MYTRAJ1"
+#define RUNTIME_MAGIC "MYRUNT2"
+#define RUNTIME_VARIANT_LENGTH 16
+#define TRACE_MAGIC "MYTRACE"
+#define TRACE_MAX_SAMPLES 16 //sampled batches kept per problem (see trace_buffer_t)
+#define TRACE_INSTANCES 1 //instances traced per function, r, range and dimension, the trace grows with it
+#define REPLAY_REPEATS 10 //passes of --replay over the samples of a problem
+#define MAX_WORKERS TRAJECTORY_MAX_RINGS //launcher threads, each one logs into its own trajectory ring
+#define RESULT_PATH_LENGTH 256 //paths in the exdata folders of the COCO partitions
+#define MAX_NUMA_NODES 64
+#define MAX_COST_KEYS 1024 //(function, variant, dimension) triples of the cost model
+#define COCO_PREFETCH_DEPTH 2 //COCO problems constructed ahead of the running one, 0 constructs them on demand
+#define INTERLEAVE_WIDTH 8 //problems a launcher worker runs interleaved (see launcher_run_jobs), 1 runs them one by one
+#define INTERLEAVE_MAX_DIMENSION 10 //largest dimension of the interleaved problems
+#define COLUMN_EVALUATION 0 //1 evaluates the points of interleaved problems together (see my_evaluate_problems), pays off with vectorized math (-O3 -ffast-math)
+#define COLUMN_TILE 16 //points per tile of the evaluation across problems
+#define ROTATION_TILE 64 //rows and columns of the matrix per cache tile (see multiply_points)
+#define MAX_SUITE_FUNCTIONS 32 //built-in functions selected by --functions
+#define PLAN_CALIBRATION_SECONDS 0.1 //time of the benchmark of every (function, variant, r, dimension) setting (see plan_benchmark)
+#define DEADLINE_MARGIN 0.05 //fraction of --deadline kept for the output of the results
+#define PLAN_SCRATCH_PATH "./output/plan.tmp" //result file written and removed by plan_benchmark
+#define DEADLINE_FIT_ROUNDS 3 //benchmarks at the lowered budget before the fit of --deadline is kept
+#define MAX_SWEEP_CONFIGURATIONS 256 //(variant, N, CR, F) configurations of --sweep
+#define SWEEP_MAX_VALUES 16 //values of one field of a --sweep grid
+#define SWEEP_TABLE_PATH "./output/sweep.txt" //results table of --sweep, unless --sweep-table is given
+#define ALLOC_ACCOUNTING 0 //1 counts the allocations of this file per phase and reports them at exit
+
+typedef double (*my_evaluate_t)(const double *x, size_t dimension, const double *optimal);
+
+//ALLOCATION_ACCOUNTING
+/**
+ * Allocation accounting (ALLOC_ACCOUNTING): the calls of this file to malloc, free and the COCO
+ * allocators go to counting wrappers. Every block carries a header with its size and the phase
+ * its thread was in when it was allocated (see ALLOC_PHASE). alloc_report prints for each phase
+ * the blocks and bytes allocated, the peak of its live bytes and the blocks still live at exit.
+ * Memory that the COCO library allocates for itself is not counted. Neither are the partition
+ * processes of the COCO experiment, which leave through _exit.
+ */
+#define ALLOC_PHASES(X) \
+  X(ALLOC_PHASE_STARTUP, "startup") \
+  X(ALLOC_PHASE_CATALOG, "catalog build") \
+  X(ALLOC_PHASE_SETUP, "problem setup") \
+  X(ALLOC_PHASE_GENERATIONS, "generation loop") \
+  X(ALLOC_PHASE_OUTPUT, "output")
+
+#define ALLOC_PHASE_ENUM(ID, NAME) ID,
+enum { ALLOC_PHASES(ALLOC_PHASE_ENUM) NUMBER_OF_ALLOC_PHASES };
+#undef ALLOC_PHASE_ENUM
+
+#if ALLOC_ACCOUNTING
+typedef union alloc_header{
+  struct{
+    size_t size;
+    int phase;
+  }block;
+  long double alignment; //keeps the blocks aligned like the ones of malloc
+}alloc_header_t;
+
+typedef struct alloc_phase_stats{
+  size_t allocations;
+  size_t bytes;
+  size_t live_blocks; //blocks of the phase not freed yet
+  size_t live_bytes;
+  size_t peak_bytes;
+}alloc_phase_stats_t;
+
+alloc_phase_stats_t alloc_stats[NUMBER_OF_ALLOC_PHASES];
+size_t alloc_live_bytes = 0;
+size_t alloc_peak_bytes = 0;
+static __thread int alloc_phase = ALLOC_PHASE_STARTUP; //phase of the calling thread
+
+static void alloc_raise_peak(size_t *peak, size_t live) {
+  size_t seen = __atomic_load_n(peak, __ATOMIC_RELAXED);
+  while (live > seen && !__atomic_compare_exchange_n(peak, &seen, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+static void *alloc_malloc(size_t size) {
+  alloc_header_t *header = (alloc_header_t *)malloc(sizeof(alloc_header_t) + size);
+  alloc_phase_stats_t *stats = &alloc_stats[alloc_phase];
+
+  if (header == NULL) {
+    return NULL;
+  }
+  header->block.size = size;
+  header->block.phase = alloc_phase;
+  __atomic_add_fetch(&stats->allocations, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&stats->bytes, size, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&stats->live_blocks, 1, __ATOMIC_RELAXED);
+  alloc_raise_peak(&stats->peak_bytes, __atomic_add_fetch(&stats->live_bytes, size, __ATOMIC_RELAXED));
+  alloc_raise_peak(&alloc_peak_bytes, __atomic_add_fetch(&alloc_live_bytes, size, __ATOMIC_RELAXED));
+  return header + 1;
+}
+
+static void alloc_free(void *pointer) {
+  alloc_header_t *header;
+  alloc_phase_stats_t *stats;
+
+  if (pointer == NULL) {
+    return;
+  }
+  header = (alloc_header_t *)pointer - 1;
+  stats = &alloc_stats[header->block.phase];
+  __atomic_sub_fetch(&stats->live_blocks, 1, __ATOMIC_RELAXED);
+  __atomic_sub_fetch(&stats->live_bytes, header->block.size, __ATOMIC_RELAXED);
+  __atomic_sub_fetch(&alloc_live_bytes, header->block.size, __ATOMIC_RELAXED);
+  free(header);
+}
+
+static void *alloc_coco_allocate_memory(size_t size) {
+  void *memory = alloc_malloc(size);
+  if (memory == NULL) {
+    fprintf(stderr, "Memory allocation of %lu bytes failed.\n", (unsigned long)size);
+    exit(EXIT_FAILURE);
+  }
+  return memory;
+}
+
+static double *alloc_coco_allocate_vector(size_t number_of_elements) {
+  return (double *)alloc_coco_allocate_memory(number_of_elements * sizeof(double));
+}
+
+/* Moves a string allocated by the COCO library into a counted block. */
+static char *alloc_adopt_string(char *string) {
+  char *copy = (char *)alloc_coco_allocate_memory(strlen(string) + 1);
+  strcpy(copy, string);
+  coco_free_memory(string);
+  return copy;
+}
+
+#define ALLOC_PHASE_NAME(ID, NAME) NAME,
+static const char *const alloc_phase_names[] = { ALLOC_PHASES(ALLOC_PHASE_NAME) };
+#undef ALLOC_PHASE_NAME
+
+static void alloc_report(void) {
+  size_t live_blocks = 0;
+
+  printf("allocations by phase: blocks, bytes, peak live bytes, blocks and bytes live at exit\n");
+  for (int phase = 0; phase < NUMBER_OF_ALLOC_PHASES; phase++) {
+    const alloc_phase_stats_t *stats = &alloc_stats[phase];
+    printf("  %-16s %12lu %16lu %14lu %10lu %14lu\n", alloc_phase_names[phase], (unsigned long)stats->allocations,
+           (unsigned long)stats->bytes, (unsigned long)stats->peak_bytes, (unsigned long)stats->live_blocks,
+           (unsigned long)stats->live_bytes);
+    live_blocks += stats->live_blocks;
+  }
+  printf("  peak of all phases %lu bytes\n", (unsigned long)alloc_peak_bytes);
+  if (alloc_stats[ALLOC_PHASE_GENERATIONS].allocations > 0) {
+    printf("  the generation loop allocated %lu blocks\n", (unsigned long)alloc_stats[ALLOC_PHASE_GENERATIONS].allocations);
+  }
+  if (live_blocks > 0) {
+    printf("  %lu blocks were not freed\n", (unsigned long)live_blocks);
+  }
+  fflush(stdout);
+}
+
+#define malloc(size) alloc_malloc(size)
+#define free(pointer) alloc_free(pointer)
+#define coco_allocate_memory(size) alloc_coco_allocate_memory(size)
+#define coco_allocate_vector(number_of_elements) alloc_coco_allocate_vector(number_of_elements)
+#define coco_free_memory(pointer) alloc_free(pointer)
+#define coco_strdupf(...) alloc_adopt_string(coco_strdupf(__VA_ARGS__))
+#define ALLOC_PHASE(PHASE) (alloc_phase = (PHASE))
+#else
+#define ALLOC_PHASE(PHASE) ((void)0)
+#endif
+
+//INTEGER_TABLE
+typedef struct integer_table{
+  size_t stride; //values per integer coordinate (largest upper bound + 1)
+  double *sums[2]; //sums[k][i*stride + v]: term k of the function for integer coordinate i at value v
+}integer_table_t;
+
+typedef double (*my_table_evaluate_t)(const double *x, size_t dimension, size_t number_of_integer_variables, const double *optimal, const integer_table_t *table);
+
+/* Per-coordinate terms of a separable function; the function is a combination of number_of_sums sums of terms. */
+typedef struct separable_kernel{
+  size_t number_of_sums;
+  double (*term[2])(double shifted_x, size_t i, size_t number_of_variables);
+}separable_kernel_t;
+
+/**
+ * Terms of a function that is a combination of number_of_sums sums over the indices p of its terms.
+ * The terms of index p depend on x[p] only, or on x[p] and x[p + 1] for chain kernels (then
+ * p < number_of_variables - 1).
+ */
+typedef struct delta_kernel{
+  size_t number_of_sums;
+  int chain;
+  void (*terms)(const double *x, const double *opt, size_t p, size_t number_of_variables, double *t);
+}delta_kernel_t;
+
+typedef double (*delta_finalize_t)(const double *sums, size_t number_of_variables);
+
+/**
+ * Peaks of a Gallagher function in the rotated coordinates of its problem (see gallagher_new), in
+ * structure-of-arrays form: row i of scales and scaled_centers holds s_i and s_i * c_i for the scales
+ * s_i and the center c_i of peak i, so the distances of a batch of points to all peaks are two
+ * matrix products. The arrays and the scratch of the products share one allocation.
+ */
+typedef struct gallagher{
+  size_t number_of_peaks;
+  double *scales; //number_of_peaks x dimension
+  double *scaled_centers; //number_of_peaks x dimension, row 0 (the optimum) is 0
+  double *offsets; //sum_j s_ij c_ij^2 per peak
+  double *log_ratios; //log(v_i / v_0) for the peak values v_i
+  double *squares; //DE_N x dimension, squared rotated coordinates of a batch
+  double *products; //2 x DE_N x number_of_peaks, the two products of a batch
+}gallagher_t;
 
 typedef struct my_problem{
   char* function_name;
   double *smallest; //[0,1],[0,3],[0,7],[0,15],[0,31]
   double *largest;
   size_t r;
+  size_t number_of_integer_variables; //integer variables are the first ones, continuous ones follow
   double *optimal;
   double *best_solution;
   int evaluate_result[NUMBER_OF_TARGET];
+  int first_hit[NUMBER_OF_TARGET]; //evaluation_cnt + evaluations of the run when the target was first hit, -1 if not yet
   size_t dimension;
   int evaluation_cnt;
   size_t instance; //location of optimal solution
   size_t end_flag;
+  const my_plugin_function_t *function; //evaluation entry points (built-in or plugin)
+  my_evaluate_t evaluate; //function->evaluate or its fixed-dimension instantiation
+  integer_table_t *integer_table; //lookup table of the integer block while the problem runs, NULL if not table-driven
+  my_table_evaluate_t table_evaluate;
+  int mapped; //function_name, smallest, largest and optimal point into the mapped catalog
+  double *rotation; //rotation matrix of a rotated or Gallagher function while the problem runs (dimension x dimension, row-major), NULL otherwise
+  double *rotation_scratch; //DE_N shifted points, their rotations and the zero optimum of the rotated coordinates
+  gallagher_t *gallagher; //peaks of a Gallagher function while the problem runs, NULL otherwise
 }MY_PROBLEM;
 
+/**
+ * Catalog file (see open_catalog): a catalog_header_t, the NUMBER_OF_TARGET targets, one
+ * catalog_record_t per problem and the doubles of the problems. All fields are in the byte order
+ * of the machine and 8-byte aligned, so the file is used in place once mapped.
+ */
+typedef struct catalog_header{
+  char magic[8]; //CATALOG_MAGIC
+  uint32_t version; //CATALOG_VERSION
+  uint32_t number_of_target;
+  uint32_t random_seed;
+  uint32_t number_of_plugin_functions;
+  uint64_t number_of_problem;
+  uint64_t data_offset; //byte offset of the doubles
+}catalog_header_t;
+
+typedef struct catalog_record{
+  char function_name[CATALOG_FUNCTION_NAME_LENGTH];
+  uint64_t r;
+  uint64_t number_of_integer_variables;
+  uint64_t dimension;
+  uint64_t instance;
+  uint64_t offset; //index of smallest in the doubles; largest and optimal follow, dimension doubles each
+}catalog_record_t;
+
+/**
+ * Runtime file (see --runtimes): a runtime_header_t, the NUMBER_OF_TARGET targets and one
+ * runtime_record_t per problem in the order the problems were run. my_postprocess reads it.
+ */
+typedef struct runtime_header{
+  char magic[8]; //RUNTIME_MAGIC
+  uint32_t number_of_target;
+  uint32_t budget_multiplier;
+}runtime_header_t;
+
+typedef struct runtime_record{
+  char function_name[CATALOG_FUNCTION_NAME_LENGTH];
+  char variant[RUNTIME_VARIANT_LENGTH];
+  uint64_t r;
+  uint64_t range; //range directory of the result file (6 for [0,1])
+  uint64_t dimension;
+  uint64_t instance;
+  int64_t evaluations; //evaluations done on the problem
+  int32_t evaluate_result[NUMBER_OF_TARGET]; //evaluations of the best restart when it hit the target, -1 if the target was not hit
+  int32_t first_hit[NUMBER_OF_TARGET]; //evaluations of all restarts up to the first hit, -1 if the target was not hit
+}runtime_record_t;
+
+/**
+ * Trace file (see --trace): a trace_header_t, then per problem, in the order the problems end, a
+ * trace_record_t, the smallest, largest and optimal points (dimension doubles each) and
+ * number_of_samples samples of 1 + DE_N * (dimension + 1) doubles: the evaluations done on the
+ * problem before the sampled batch, its DE_N encoded points and their values. --replay reads it.
+ */
+typedef struct trace_header{
+  char magic[8]; //TRACE_MAGIC
+  uint32_t population_size; //DE_N
+  uint32_t padding;
+}trace_header_t;
+
+typedef struct trace_record{
+  char function_name[CATALOG_FUNCTION_NAME_LENGTH];
+  char variant[RUNTIME_VARIANT_LENGTH];
+  uint64_t r;
+  uint64_t number_of_integer_variables;
+  uint64_t dimension;
+  uint64_t instance;
+  uint64_t number_of_samples;
+}trace_record_t;
+
 double target[NUMBER_OF_TARGET];
 
+//DE_WORKSPACE
+typedef struct de_workspace{
+  size_t population_size; //N, CR and F of the variant the workspace was made for
+  double cr;
+  double f;
+  double **population; //the continuous block alone if the integer block is in codes
+  double **trial;
+  double **tmp;
+  double *mutate;
+  double *rnd_vals;
+  double *repair_lower; //search domain of the encoding, used by the bound repair of the mutation
+  double *repair_upper;
+  size_t **changed; //coordinates the crossover took from the mutant, ascending
+  size_t *number_of_changed;
+  double *parent; //an individual unpacked from the codes: the one of the crossover, or the best one in de_run_free
+  size_t number_of_codes; //integer variables stored as codes (DE_COMPACT_POPULATION), 0 if population holds the whole individuals
+  unsigned char **codes; //codes[i][j]: index of integer coordinate j of individual i in decode[j]
+  const double **decode; //decode[j]: the values integer coordinate j takes once encoded, ascending
+  size_t *number_of_values; //number_of_values[j]: the size of decode[j]
+  double *code_values; //the decode tables, one per distinct upper bound
+}de_workspace_t;
+
+/**
+ * Per-coordinate statistics of a population, computed in one pass by population_stats_compute.
+ */
+typedef struct population_stats{
+  size_t dimension;
+  size_t number_of_integer_variables;
+  size_t number_of_points;
+  const double *lower_bounds;
+  const double *upper_bounds;
+  double *mean;
+  double *m2; //sum of the squared deviations from the mean
+  double *min;
+  double *max;
+  size_t stride; //histogram bins per integer coordinate
+  size_t *histogram; //histogram[j*stride + v]: points whose integer coordinate j is lower_bounds[j] + v
+}population_stats_t;
+
+typedef struct nd_candidate{
+  double f1;
+  double f2;
+  size_t index; //index of the candidate in its batch
+}nd_candidate_t;
+
+/**
+ * Non-dominated archive of a bi-objective DE run. As no point of the front dominates another, the
+ * front sorted by ascending f1 has strictly descending f2, so dominance is decided by one binary
+ * search over f1 and an insertion only moves the tail of the front.
+ */
+typedef struct nd_archive{
+  size_t size;
+  size_t capacity;
+  double *front; //front[2*k], front[2*k + 1]: f1 and f2 of point k, f1 ascending and f2 strictly descending
+  nd_candidate_t candidates[DE_N]; //the batch being inserted, sorted by (f1, f2)
+}nd_archive_t;
+
+/**
+ * State of the incremental evaluation of the trials of a DE run: the terms and sums of the function
+ * for every individual of the population and for its trial.
+ */
+typedef struct de_delta{
+  const delta_kernel_t *kernel;
+  delta_finalize_t finalize;
+  size_t number_of_terms; //dimension, or dimension - 1 for chain kernels
+  double **terms; //terms[i][k*number_of_terms + p]: term k of index p of individual i
+  double **trial_terms;
+  size_t population_size;
+  double (*sums)[2];
+  double (*trial_sums)[2];
+  size_t *age; //incremental evaluations since the last evaluation from scratch
+  size_t *trial_age;
+  size_t **affected; //indices whose terms were recomputed for trial i, ascending
+  size_t *number_of_affected;
+}de_delta_t;
+
+typedef struct de_kernels{
+  size_t dimension; //0 for the generic kernels
+  void (*encoding_step)(double **x, double **tmp, size_t number_of_points, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds);
+  void (*generation)(de_workspace_t *workspace, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds, coco_random_state_t *random_generator);
+}de_kernels_t;
+
+typedef struct de_variant{
+  int encoding;
+  int approach;
+  const char *name;
+  size_t population_size; //N
+  double cr;
+  double f;
+  void (*initialization)(double **population, size_t population_size, size_t dimension, size_t number_of_integer_variables, const double *lower_bounds, const double *upper_bounds, coco_random_state_t *random_generator);
+  de_kernels_t kernels[NUMBER_OF_FIXED_DIMENSIONS + 1]; //one per fixed dimension, then the generic ones
+}de_variant_t;
+
+/**
+ * Batches told to the DE runs of a problem that are sampled for the trace (see trace_sample): every
+ * interval-th batch is kept, and once TRACE_MAX_SAMPLES are kept every other one is dropped and the
+ * interval doubles, so the samples stay spread from the first generation to the converged ones.
+ */
+typedef struct trace_buffer{
+  size_t dimension;
+  size_t number_of_samples;
+  size_t interval;
+  size_t countdown; //batches until the next sample
+  double *samples; //TRACE_MAX_SAMPLES samples in the layout of the trace file
+}trace_buffer_t;
+
+typedef enum de_run_state{
+  DE_RUN_POPULATION, //the values of the initial population are asked
+  DE_RUN_TRIALS, //the values of the trials of a generation are asked
+  DE_RUN_DONE
+}de_run_state_t;
+
+/**
+ * State of a DE run on a problem of the custom suite between the steps of the DE: the run asks for
+ * the values of its population of encoded points (de_run_ask) and goes on once they are told (de_run_tell), so
+ * the caller decides how the points are evaluated and can interleave the runs of several problems.
+ */
+typedef struct de_run{
+  MY_PROBLEM *problem;
+  const de_variant_t *variant;
+  const de_kernels_t *kernels;
+  coco_random_state_t *random_generator;
+  de_workspace_t *workspace;
+  de_delta_t *delta;
+  population_stats_t *stats;
+  double *sum;
+  double *sum2;
+  size_t max_budget;
+  int evaluation;
+  int output_cnt;
+  int min_pos;
+  de_run_state_t state;
+  trace_buffer_t *trace; //samples of the problem, NULL if it is not traced
+  double *values; //where the values of the asked points go, value_population or value_trial
+  double *value_population; //the population size of the variant
+  double *value_trial;
+}de_run_t;
+
+/**
+ * The runs of the DE variant on a problem of the custom suite, restarted until the budget of the
+ * problem is exhausted, and the result file they write to (see my_problem_job_begin).
+ */
+typedef struct my_problem_job{
+  MY_PROBLEM *problem;
+  const de_variant_t *variant;
+  coco_random_state_t *random_generator;
+  FILE *runtime_file;
+  de_run_t *run; //the current run, NULL between two runs
+  trace_buffer_t *trace; //NULL unless --trace
+  long number_of_runs;
+  int aborted; //the campaign stopped before the job was done (see campaign_stopping)
+  char titlestr[128];
+}my_problem_job_t;
+
+//TRAJECTORY
+/**
+ * Trajectory logging (--trajectory): every DE generation that used to be traced by ea_sd_calc,
+ * the worker pushes the evaluation count, the best value and the standard deviation of every
+ * coordinate of the encoded population into its own single-producer ring, without locks. A
+ * background thread drains the rings into one file per problem next to the result file
+ * (<result>.traj): the magic TRAJECTORY_MAGIC, the dimension as uint64_t, then one row of
+ * dimension + 2 doubles (evaluations, best value, SDs) per sample, which can be read with
+ * numpy.fromfile(path, dtype=float, offset=16).reshape(-1, dimension + 2).
+ */
+enum { TRAJECTORY_BEGIN, TRAJECTORY_SAMPLE, TRAJECTORY_END };
+
+typedef struct trajectory_record{
+  int type;
+  size_t dimension;
+  double evaluations;
+  double best_value;
+  char path[TRAJECTORY_PATH_LENGTH]; //TRAJECTORY_BEGIN
+  double sd[TRAJECTORY_MAX_DIMENSION]; //TRAJECTORY_SAMPLE
+}trajectory_record_t;
+
+typedef struct trajectory_ring{
+  trajectory_record_t records[TRAJECTORY_RING_SIZE];
+  size_t head; //records pushed by the worker
+  size_t tail; //records written by the writer thread
+  FILE *fp; //file of the current problem, used by the writer thread only
+}trajectory_ring_t;
+
+typedef struct trajectory_logger{
+  pthread_t thread;
+  pthread_key_t ring_key; //ring of the calling worker
+  pthread_mutex_t register_mutex;
+  trajectory_ring_t *rings[TRAJECTORY_MAX_RINGS];
+  size_t number_of_rings;
+  int stop;
+}trajectory_logger_t;
+
+trajectory_logger_t *trajectory_logger = NULL; //NULL if trajectory logging is disabled
+
+//PLUGINS
+void *plugin_handles[MAX_PLUGINS];
+const my_plugin_t *plugins[MAX_PLUGINS];
+size_t number_of_plugins = 0;
+
+//CATALOG
+const char *suite_functions = "f1,f3,f8"; //--functions=<list>, built-in functions of the custom suite
+const char *coco_suite_name = "bbob-mixint"; //--suite=<name>, suite of the COCO experiment
+const char *catalog_path = NULL; //--catalog=<path>
+void *catalog_map = NULL;
+size_t catalog_size = 0;
+
+//RUNTIMES
+const char *runtime_path = NULL; //--runtimes=<path>
+
+//TRACE
+const char *trace_path = NULL; //--trace=<path>
+FILE *trace_file = NULL;
+pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER; //the launcher workers write their records to the same file
+const char *replay_path = NULL; //--replay=<path>
+
+//LAUNCHER
+long launcher_workers = -1; //--workers=<n>, -1 runs the problems in order on the main thread, 0 one worker per usable CPU
+const char *timing_path = NULL; //--timing=<path>
+int plan_only = 0; //--plan
+double deadline_seconds = 0; //--deadline=<[[hh:]mm:]ss>, 0 if the campaign has no deadline
+int deadline_fit_instances = 0; //--fit=instances drops instances instead of lowering the budget
+double campaign_start = 0; //launcher_clock() when the process started
+double campaign_stop_time = 0; //launcher_clock() after which no problem is started or continued, 0 if none
+volatile sig_atomic_t campaign_stop_signal = 0; //set by SIGTERM and SIGUSR1 in the launcher
+const char *slice_dimensions = NULL; //--dimensions=<list>, NULL keeps every dimension
+long slice_instances = 0; //--instances=<n>, 0 keeps every instance
+
+//SWEEP
+de_variant_t sweep_variants[MAX_SWEEP_CONFIGURATIONS]; //configurations of --sweep, run by the launcher instead of --variant
+char sweep_names[MAX_SWEEP_CONFIGURATIONS][RUNTIME_VARIANT_LENGTH];
+const de_variant_t *sweep_list[MAX_SWEEP_CONFIGURATIONS];
+size_t number_of_sweep_variants = 0;
+const char *sweep_table_path = SWEEP_TABLE_PATH; //--sweep-table=<path>
+
+/* Usable CPUs, ordered so that consecutive workers alternate between the NUMA nodes. */
+typedef struct numa_topology{
+  size_t number_of_nodes;
+  size_t number_of_cpus;
+  int *cpus;
+}numa_topology_t;
+
+numa_topology_t numa_topology_discover(void);
+static double launcher_clock(void);
+int campaign_stopping(void);
+double parse_duration(const char *text);
+
+/* Outcome of a work item, for the results table of --sweep. */
+typedef struct launcher_result{
+  size_t targets; //targets hit
+  int solved; //1 if the final target was hit
+  double evaluations; //evaluations of all restarts to the final target, or all the ones done if it was not hit
+}launcher_result_t;
+
+typedef struct launcher{
+  MY_PROBLEM *problems;
+  size_t number_of_problem;
+  const de_variant_t *const *variants;
+  size_t number_of_variants;
+  size_t max_dimension;
+  FILE *runtime_file;
+  size_t *order; //work items (problem-major, then variant) from the longest to the shortest expected one
+  size_t number_of_items; //work items in order, fewer than all if the deadline dropped some
+  double *expected; //expected time of every work item
+  double overhead; //time of the setup and the output of a work item, which does not depend on the budget
+  double *seconds; //measured time of every work item, -1 if it was not done
+  launcher_result_t *results; //outcome of every work item done, NULL without --sweep
+  size_t next; //next position in order, taken atomically
+}launcher_t;
+
+/**
+ * Expected time of a work item. The seed is dimension * budget; a timing report of a previous run
+ * (--timing) replaces it by the mean measured time of the same function, variant and dimension, or
+ * scales it by the measured time per seed unit of the function, or of all problems.
+ */
+typedef struct cost_key{
+  char function_name[CATALOG_FUNCTION_NAME_LENGTH];
+  const de_variant_t *variant;
+  size_t dimension;
+  double seconds;
+  double seed;
+  size_t count;
+}cost_key_t;
+
+typedef struct cost_model{
+  cost_key_t keys[MAX_COST_KEYS];
+  size_t number_of_keys;
+  double seconds; //measured time and seed of all keys
+  double seed;
+}cost_model_t;
+
+typedef struct launcher_worker{
+  launcher_t *launcher;
+  int cpu; //-1 if the worker is not pinned
+  pthread_t thread;
+}launcher_worker_t;
+
 void free_problem(MY_PROBLEM* problem);
 void f1(const double *x, double *y, size_t dimension, double* optimal);
 void f8(const double *x, double *y, size_t dimension, double* optimal);
 void f15(const double *x, double *y, size_t dimension, double* optimal);
-void my_evaluate_func(const double *x, double *y, const char * function_name, size_t dimension, double * optimal);
-MY_PROBLEM* init_problem(coco_random_state_t *random_generator);
-void my_example_experiment(const char *file_name, coco_random_state_t *random_generator);
+void my_evaluate_population(const MY_PROBLEM *problem, double **x, size_t number_of_points, double *y);
+double my_evaluate_point(const MY_PROBLEM *problem, const double *x);
+const my_plugin_function_t *find_function(const char *function_name);
+const my_plugin_function_t *find_builtin_function(const char *function_name);
+my_evaluate_t select_evaluate(const my_plugin_function_t *function, size_t dimension);
+void my_problem_prepare(MY_PROBLEM *problem);
+void my_problem_release(MY_PROBLEM *problem);
+int my_problem_range(const MY_PROBLEM *problem);
+FILE *open_runtimes(const char *path);
+void write_runtime_record(FILE *fp, const MY_PROBLEM *problem, const de_variant_t *variant);
+void write_result_file(FILE *fp, const MY_PROBLEM *problem);
+de_delta_t *de_delta_new(const MY_PROBLEM *problem, const de_variant_t *variant);
+void de_delta_free(de_delta_t *delta);
+void de_delta_evaluate_population(de_delta_t *delta, const MY_PROBLEM *problem, double **x, double *y);
+void de_delta_evaluate_trials(de_delta_t *delta, const MY_PROBLEM *problem, const de_workspace_t *workspace, double **x, double *y);
+void de_delta_accept(de_delta_t *delta, size_t i);
+MY_PROBLEM* init_problem(coco_random_state_t *random_generator, size_t *number_of_problem);
+MY_PROBLEM* open_catalog(const char *path, coco_random_state_t *random_generator, size_t *number_of_problem);
+void close_catalog(void);
+void my_example_experiment(const char *file_name, const de_variant_t *variant, coco_random_state_t *random_generator);
+int run_my_problem(MY_PROBLEM *problem, const de_variant_t *variant, coco_random_state_t *random_generator, FILE *runtime_file);
+void my_problem_job_begin(my_problem_job_t *job, MY_PROBLEM *problem, const de_variant_t *variant, coco_random_state_t *random_generator, FILE *runtime_file);
+double **my_problem_job_ask(my_problem_job_t *job);
+void my_problem_job_end(my_problem_job_t *job);
+int my_problem_batchable(const MY_PROBLEM *problem);
+void my_evaluate_problems(const MY_PROBLEM *const *problems, double *const *x, size_t number_of_points, double *y, double *columns);
+MY_PROBLEM *load_problems(coco_random_state_t *random_generator, size_t *number_of_problem);
+void my_example_launcher(const de_variant_t *const *variants, size_t number_of_variants, coco_random_state_t *random_generator);
+void load_plugin(const char *path);
+void unload_plugins(void);
+void trajectory_logger_start(void);
+void trajectory_logger_stop(void);
+void trajectory_begin(const char *titlestr, size_t dimension);
+void trajectory_sample(double evaluations, double best_value, const double *sd, size_t dimension);
+void trajectory_end(void);
+void trace_start(const char *path);
+void trace_stop(void);
+trace_buffer_t *trace_buffer_new(size_t dimension);
+void trace_buffer_free(trace_buffer_t *trace);
+void trace_sample(trace_buffer_t *trace, double **x, const double *values, double evaluations);
+void trace_write(const trace_buffer_t *trace, const MY_PROBLEM *problem, const de_variant_t *variant);
+void replay_trace(const char *path);
 
 //COCO_SETTINGS
 int instance_cnt = 0;
@@ -63,6 +756,7 @@ int instance_cnt = 0;
  * Increase the budget multiplier value gradually to see how it affects the runtime.
  */
 static const unsigned int BUDGET_MULTIPLIER = 10000;
+unsigned int budget_multiplier; //of the custom suite, BUDGET_MULTIPLIER unless --deadline lowered it
 
 /**
  * The maximal number of independent restarts allowed for an algorithm that restarts itself.
@@ -75,23 +769,18 @@ static const long INDEPENDENT_RESTARTS = 1e5;
 static const uint32_t RANDOM_SEED = 0xdeadbeef;
 
 /**
- * A function type for evaluation functions, where the first argument is the vector to be evaluated and the
- * second argument the vector to which the evaluation result is stored.
- */
-typedef void (*evaluate_function_t)(const double *x, double *y);
-
-/**
- * A pointer to the problem to be optimized (needed in order to simplify the interface between the optimization
- * algorithm and the COCO platform).
+ * A function type for evaluation functions, where the first argument is the problem, the second
+ * argument the vector to be evaluated and the third argument the vector to which the evaluation
+ * result is stored. The problem is passed explicitly, so several problems can be optimized at once.
  */
-static coco_problem_t *PROBLEM; 
+typedef void (*evaluate_function_t)(coco_problem_t *problem, const double *x, double *y);
 
 /**
  * Calls coco_evaluate_function() to evaluate the objective function
  * of the problem at the point x and stores the result in the vector y
  */
-static void evaluate_function(const double *x, double *y) {
-  coco_evaluate_function(PROBLEM, x, y);
+static void evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  coco_evaluate_function(problem, x, y);
 }
 
 /* Structure and functions needed for timing the experiment */
@@ -110,7 +799,40 @@ void example_experiment(const char *suite_name,
                         const char *suite_options,
                         const char *observer_name,
                         const char *observer_options,
+                        const de_variant_t *variant,
                         coco_random_state_t *random_generator);
+void example_experiment_partitioned(const char *suite_name,
+                                    const char *suite_options,
+                                    const char *observer_name,
+                                    const char *result_folder,
+                                    const de_variant_t *variant,
+                                    coco_random_state_t *random_generator);
+
+/**
+ * Constructs the problems of a COCO suite on a background thread, in suite order and at most
+ * COCO_PREFETCH_DEPTH ahead of the consumer. The problems are constructed without observer: COCO
+ * allows one open logger at a time, so the consumer adds the observer when it starts a problem and
+ * the observer files are written in the same order as with coco_suite_get_next_problem.
+ */
+enum { PREFETCH_SLOTS = COCO_PREFETCH_DEPTH > 0 ? COCO_PREFETCH_DEPTH : 1 };
+
+typedef struct problem_prefetcher{
+  coco_suite_t *suite;
+  size_t number_of_problems;
+  coco_problem_t *slots[PREFETCH_SLOTS];
+  size_t head; //next slot to take
+  size_t count; //constructed problems not taken yet
+  size_t next_index; //next suite index to construct
+  int done; //all problems were constructed
+  int stop;
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  pthread_t thread;
+}problem_prefetcher_t;
+
+problem_prefetcher_t *problem_prefetcher_start(coco_suite_t *suite);
+coco_problem_t *problem_prefetcher_next(problem_prefetcher_t *prefetcher, coco_observer_t *observer);
+void problem_prefetcher_stop(problem_prefetcher_t *prefetcher);
 
 static timing_data_t *timing_data_initialize(coco_suite_t *suite);
 static void timing_data_time_problem(timing_data_t *timing_data, coco_problem_t *problem);
@@ -118,65 +840,266 @@ static void timing_data_finalize(timing_data_t *timing_data);
 char *get_short_function_number(const char *problem_name);
 
 //EA prototype
-void ea_group_initialization(double** population,
-                                  size_t dimension,
-                                  const double *lower_bounds,
-                                  const double *upper_bounds,
-                                  coco_random_state_t *random_generator);
-
-void ea_group_encoding(double** x,
-                       double** tmp,
-                       size_t dimension,
-                       const double *lower_bounds,
-                       const double *upper_bounds);
+const de_variant_t *lookup_de_variant(const char *name);
+const de_variant_t *find_de_variant(const char *name);
+void sweep_add(const char *spec);
+const de_variant_t *find_de_variant_by_code(int encoding, int approach);
+const de_kernels_t *de_select_kernels(const de_variant_t *variant, size_t dimension);
+
+de_workspace_t *de_workspace_new(size_t dimension,
+                                 size_t number_of_codes,
+                                 const double *lower_bounds,
+                                 const double *upper_bounds,
+                                 const de_variant_t *variant);
+
+void de_workspace_free(de_workspace_t *workspace);
+
+void de_population_store(de_workspace_t *workspace, size_t i, const double *x, size_t dimension);
+
+void de_population_load(const de_workspace_t *workspace, size_t i, double *x, size_t dimension);
 
 void round_vec(double *x,
-               size_t dimention_size,
-               const double *lower_bounds,
+               size_t number_of_integer_variables,
                const double *upper_bounds);
 
 void new_round_vec(double *x,
-                   size_t dimention_size,
-                   const double *lower_bounds,
-                   const double *upper_bounds);
+                   size_t number_of_integer_variables,
+                   const double *upper_bounds,
+                   int approach);
 
 void decoding_vec(double *population,
                   size_t dimention_size,
-                  const double *lower_bounds,
+                  size_t number_of_integer_variables,
                   const double *upper_bounds);
 
 void ea_sd_calc(double* sum,
                 double* sum2,
                 double** tmp,
-                size_t dimension,
-                FILE *fp);
+                size_t number_of_points,
+                size_t dimension);
+
+population_stats_t *population_stats_new(size_t dimension,
+                                         size_t number_of_integer_variables,
+                                         const double *lower_bounds,
+                                         const double *upper_bounds);
+
+void population_stats_free(population_stats_t *stats);
+
+void population_stats_compute(population_stats_t *stats, double **x, size_t number_of_points);
+
+int population_stats_converged(const population_stats_t *stats, double threshold);
+
+nd_archive_t *nd_archive_new(void);
+
+void nd_archive_free(nd_archive_t *archive);
+
+int nd_archive_dominated(const nd_archive_t *archive, double f1, double f2);
+
+void nd_archive_insert(nd_archive_t *archive, double f1, double f2);
+
+size_t nd_archive_insert_batch(nd_archive_t *archive, double (*values)[2], size_t number_of_points, int *entered);
  
 //ALGPRITHM prototype
 void de_nopcm(evaluate_function_t evaluate_func,
+                    coco_problem_t *problem,
                     const size_t dimension,
                     const size_t number_of_objectives,
+                    const size_t number_of_integer_variables,
                     const double *lower_bounds,
                     const double *upper_bounds,
                     const size_t max_budget,
+                    const de_variant_t *variant,
                     coco_random_state_t *random_generator,
                     char *titlestr);
 
-void my_de_nopcm(const char* function_name,
-                      const size_t dimension,
-                      const size_t number_of_objectives,
-                      const double *lower_bounds,
-                      const double *upper_bounds,
-                      const size_t max_budget,
-                      coco_random_state_t *random_generator,
-                      char *titlestr,
-                      MY_PROBLEM *problem);
+de_run_t *de_run_new(MY_PROBLEM *problem,
+                     const size_t max_budget,
+                     const de_variant_t *variant,
+                     coco_random_state_t *random_generator);
+
+double **de_run_ask(de_run_t *run);
+
+void de_run_evaluate(de_run_t *run, double **x);
+
+void de_run_tell(de_run_t *run);
+
+void de_run_free(de_run_t *run);
 
 /**
  * The main method initializes the random number generator and calls the example experiment on the
  * bbob suite.
+ *
+ * Options:
+ *   --plugin=<path>  loads a shared object exporting additional functions for the custom suite
+ *                    (see my_plugin.h), may be given several times
+ *   --variant=<name> runs the DE variant with the given name (L, B, U-Lf, U-Lm, U-Lb, U-B, U2-L,
+ *                    U2-B) instead of the one selected by ENCODING and APPROACH at compile time
+ *   --catalog=<path> maps the problems of the custom suite from the catalog file path, so that
+ *                    several processes share the same instances; the catalog is generated and
+ *                    written first if the file does not exist (see open_catalog)
+ *   --runtimes=<path> also writes the target hitting evaluations of every problem of the custom
+ *                    suite to path, for my_postprocess
+ *   --workers=<n>    runs the custom suite on n threads pinned across the NUMA nodes (0: one per
+ *                    usable CPU); --variant may then be given several times to run several
+ *                    variants in one process. With the COCO suite the functions are split over
+ *                    n processes instead, whose result folders are merged at the end
+ *   --timing=<path>  (with --workers) orders the problems by the times measured in the timing
+ *                    report of the previous run, if any, and writes the times of this run to it
+ *   --functions=<list> built-in functions of the custom suite, comma-separated (default f1,f3,f8,
+ *                    also f2, f12, f13, f14, f16 (weierstrass), f21 and f22 (gallagher with 101
+ *                    and 21 peaks) and f23 (katsuura));
+ *                    f2r, f3r, f12r, f13r and f14r are the rotated variants of f2, f3, f12, f13
+ *                    and f14
+ *   --suite=<name>   runs the COCO experiment on the given suite (default bbob-mixint); on a
+ *                    bi-objective one such as bbob-biobj-mixint the DE keeps a non-dominated
+ *                    archive and the results are logged by the bbob-biobj observer
+ *   --trace=<path>   samples the encoded points the DE evaluates on the first TRACE_INSTANCES
+ *                    instances of the custom suite, with their values, into the trace file path
+ *                    (see trace_record_t)
+ *   --replay=<path>  runs no experiment but replays the trace file path through the encoding
+ *                    step and the evaluation, and prints their time per point (see replay_trace)
+ *   --plan           (with --workers) benchmarks the evaluation rate of every function, variant
+ *                    and dimension and prints the predicted wall time of the campaign on the
+ *                    workers, without running it
+ *   --deadline=<[[hh:]mm:]ss> (with --workers) fits the campaign into the given wall time from
+ *                    the start of the process, e.g. the walltime of a PBS job, by lowering the
+ *                    budget multiplier, and stops it before: the problems that cannot end in time
+ *                    are not run and have no results. SIGTERM and SIGUSR1 stop the launcher the
+ *                    same way
+ *   --fit=instances  fits the deadline by running only the first instances of every setting
+ *                    instead of lowering the budget (--fit=budget)
+ *   --sweep=<variant:N:CR:F> (with --workers) runs DE configurations instead of --variant: the
+ *                    variant with population size N, crossover rate CR and scale factor F, where
+ *                    N, CR and F may be comma-separated lists whose cartesian product is run, e.g.
+ *                    U-Lb:50,100:0.5,0.9:0.5; may be given several times (see sweep_add). All
+ *                    configurations share the problems and the workers, and a results table is
+ *                    written to SWEEP_TABLE_PATH (see write_sweep_table)
+ *   --sweep-table=<path> writes the results table of --sweep to path instead
+ *   --dimensions=<list> (with --workers) runs only the problems of these dimensions, e.g. 5,10
+ *   --instances=<n>  (with --workers) runs only the first n instances of every setting
+ *   --trajectory     logs the best value and the standard deviation of every coordinate of the
+ *                    encoded population of the DE runs of the custom suite into <result>.traj
+ *                    next to the result files (see trajectory_logger_t); the launcher then runs
+ *                    its problems one by one instead of interleaved
  */
-int main(void) {
-  coco_random_state_t *random_generator = coco_random_new(RANDOM_SEED);
+int main(int argc, char **argv) {
+  coco_random_state_t *random_generator;
+  const de_variant_t *variant = find_de_variant_by_code(ENCODING, APPROACH);
+  const de_variant_t *variants[NUMBER_OF_DE_VARIANTS];
+  size_t number_of_variants = 0;
+  char result_folder[64];
+  char file_name[32];
+  const char *observer_name;
+
+  campaign_start = launcher_clock();
+  budget_multiplier = BUDGET_MULTIPLIER;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--plugin=", strlen("--plugin=")) == 0) {
+      load_plugin(argv[i] + strlen("--plugin="));
+    }
+    else if (strncmp(argv[i], "--variant=", strlen("--variant=")) == 0) {
+      if (number_of_variants == NUMBER_OF_DE_VARIANTS) {
+        fprintf(stderr, "Too many variants.\n");
+        return EXIT_FAILURE;
+      }
+      variants[number_of_variants++] = find_de_variant(argv[i] + strlen("--variant="));
+    }
+    else if (strncmp(argv[i], "--catalog=", strlen("--catalog=")) == 0) {
+      catalog_path = argv[i] + strlen("--catalog=");
+    }
+    else if (strncmp(argv[i], "--runtimes=", strlen("--runtimes=")) == 0) {
+      runtime_path = argv[i] + strlen("--runtimes=");
+    }
+    else if (strncmp(argv[i], "--workers=", strlen("--workers=")) == 0) {
+      launcher_workers = strtol(argv[i] + strlen("--workers="), NULL, 10);
+    }
+    else if (strncmp(argv[i], "--timing=", strlen("--timing=")) == 0) {
+      timing_path = argv[i] + strlen("--timing=");
+    }
+    else if (strncmp(argv[i], "--functions=", strlen("--functions=")) == 0) {
+      suite_functions = argv[i] + strlen("--functions=");
+    }
+    else if (strncmp(argv[i], "--suite=", strlen("--suite=")) == 0) {
+      coco_suite_name = argv[i] + strlen("--suite=");
+    }
+    else if (strncmp(argv[i], "--trace=", strlen("--trace=")) == 0) {
+      trace_path = argv[i] + strlen("--trace=");
+    }
+    else if (strncmp(argv[i], "--replay=", strlen("--replay=")) == 0) {
+      replay_path = argv[i] + strlen("--replay=");
+    }
+    else if (strcmp(argv[i], "--plan") == 0) {
+      plan_only = 1;
+    }
+    else if (strncmp(argv[i], "--deadline=", strlen("--deadline=")) == 0) {
+      deadline_seconds = parse_duration(argv[i] + strlen("--deadline="));
+    }
+    else if (strcmp(argv[i], "--fit=instances") == 0 || strcmp(argv[i], "--fit=budget") == 0) {
+      deadline_fit_instances = strcmp(argv[i], "--fit=instances") == 0;
+    }
+    else if (strncmp(argv[i], "--sweep=", strlen("--sweep=")) == 0) {
+      sweep_add(argv[i] + strlen("--sweep="));
+    }
+    else if (strncmp(argv[i], "--sweep-table=", strlen("--sweep-table=")) == 0) {
+      sweep_table_path = argv[i] + strlen("--sweep-table=");
+    }
+    else if (strncmp(argv[i], "--dimensions=", strlen("--dimensions=")) == 0) {
+      slice_dimensions = argv[i] + strlen("--dimensions=");
+    }
+    else if (strncmp(argv[i], "--instances=", strlen("--instances=")) == 0) {
+      slice_instances = strtol(argv[i] + strlen("--instances="), NULL, 10);
+    }
+    else if (strcmp(argv[i], "--trajectory") == 0) {
+      trajectory_logger_start();
+    }
+    else {
+      fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (number_of_sweep_variants > 0 && number_of_variants > 0) {
+    fprintf(stderr, "--sweep replaces --variant.\n");
+    return EXIT_FAILURE;
+  }
+  if (number_of_variants == 0) {
+    variants[number_of_variants++] = variant;
+  }
+  variant = variants[0];
+  if (number_of_variants > 1 && (PROBLEM_CLASS == 0 || launcher_workers < 0)) {
+    fprintf(stderr, "Several variants are only run by the launcher of the custom suite (--workers).\n");
+    return EXIT_FAILURE;
+  }
+  if ((plan_only || deadline_seconds > 0) && (PROBLEM_CLASS == 0 || launcher_workers < 0)) {
+    fprintf(stderr, "--plan and --deadline need the launcher of the custom suite (--workers).\n");
+    return EXIT_FAILURE;
+  }
+  if ((number_of_sweep_variants > 0 || slice_dimensions != NULL || slice_instances > 0)
+      && (PROBLEM_CLASS == 0 || launcher_workers < 0)) {
+    fprintf(stderr, "--sweep, --dimensions and --instances need the launcher of the custom suite (--workers).\n");
+    return EXIT_FAILURE;
+  }
+  /* the trace file records one population size, DE_N */
+  if (number_of_sweep_variants > 0 && trace_path != NULL) {
+    fprintf(stderr, "--trace cannot be combined with --sweep.\n");
+    return EXIT_FAILURE;
+  }
+  if (deadline_seconds > 0) {
+    campaign_stop_time = campaign_start + deadline_seconds * (1 - DEADLINE_MARGIN);
+  }
+  if (replay_path != NULL) {
+    replay_trace(replay_path);
+    trajectory_logger_stop();
+    unload_plugins();
+    return 0;
+  }
+  if (trace_path != NULL) {
+    trace_start(trace_path);
+  }
+
+#if ALLOC_ACCOUNTING
+  atexit(alloc_report);
+#endif
+  random_generator = coco_random_new(RANDOM_SEED);
   /* Change the log level to "warning" to get less output */
   coco_set_log_level("info");
 
@@ -211,37 +1134,16 @@ int main(void) {
    * http://numbbo.github.io/coco-doc/C/#suite-parameters and
    * http://numbbo.github.io/coco-doc/C/#observer-parameters. */
 
+  observer_name = strstr(coco_suite_name, "biobj") != NULL ? "bbob-biobj" : coco_suite_name;
   if(PROBLEM_CLASS == 0){
     if(ALGORITHM == 0){//de
-      if(ENCODING == 0){//basic encoding
-        if(APPROACH == 0){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:L-DE", random_generator);
-        }
-        else if(APPROACH == 1){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:B-DE", random_generator);
-        }
+      if(launcher_workers >= 0){
+        sprintf(result_folder, "%s-DE", variant->name);
+        example_experiment_partitioned(coco_suite_name, "", observer_name, result_folder, variant, random_generator);
       }
-      else if(ENCODING == 1){//new encoding
-        if(APPROACH == 0){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U-Lf-DE", random_generator);
-        }
-        else if(APPROACH == 1){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U-Lm-DE", random_generator);
-        }
-        else if(APPROACH == 2){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U-Lb-DE", random_generator);
-        }
-        else if(APPROACH == 3){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U-B-DE", random_generator);
-        }
-      }
-      else if(ENCODING == 2){//basic2 encoding
-        if(APPROACH == 0){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U2-L-DE", random_generator);
-        }
-        else if(APPROACH == 1){
-          example_experiment("bbob-mixint", "", "bbob-mixint", "result_folder:U2-B-DE", random_generator);
-        }
+      else{
+        sprintf(result_folder, "result_folder:%s-DE", variant->name);
+        example_experiment(coco_suite_name, "", observer_name, result_folder, variant, random_generator);
       }
     }
     else if(ALGORITHM == 1){
@@ -250,35 +1152,17 @@ int main(void) {
   }
   else{
     if(ALGORITHM == 0){//de
-      if(ENCODING == 0){//basic encoding
-        if(APPROACH == 0){
-          my_example_experiment("L-DE", random_generator);
+      if(launcher_workers >= 0){
+        if (number_of_sweep_variants > 0) {
+          my_example_launcher(sweep_list, number_of_sweep_variants, random_generator);
         }
-        else if(APPROACH == 1){
-          my_example_experiment("B-DE", random_generator);
+        else {
+          my_example_launcher(variants, number_of_variants, random_generator);
         }
       }
-      else if(ENCODING == 1){//new encoding
-        if(APPROACH == 0){
-          my_example_experiment("U-Lf-DE", random_generator);
-        }
-        else if(APPROACH == 1){
-          my_example_experiment("U-Lm-DE", random_generator);
-        }
-        else if(APPROACH == 2){
-          my_example_experiment("U-Lb-DE", random_generator);
-        }
-        else if(APPROACH == 3){
-          my_example_experiment("U-B-DE", random_generator);
-        }
-      }
-      else if(ENCODING == 2){//basic2 encoding
-        if(APPROACH == 0){
-          my_example_experiment("U2-L-DE", random_generator);
-        }
-        else if(APPROACH == 1){
-          my_example_experiment("U2-B-DE", random_generator);
-        }
+      else{
+        sprintf(file_name, "%s-DE", variant->name);
+        my_example_experiment(file_name, variant, random_generator);
       }
     }
     else if(ALGORITHM == 1){
@@ -290,6 +1174,9 @@ int main(void) {
   fflush(stdout);
 
   coco_random_free(random_generator);
+  trajectory_logger_stop();
+  trace_stop();
+  unload_plugins();
 
   return 0;
 }
@@ -304,27 +1191,37 @@ int main(void) {
  * @param observer_name Name of the observer matching with the chosen suite (e.g. "bbob-biobj"
  * when using the "bbob-biobj-ext" suite).
  * @param observer_options Options of the observer (e.g. "result_folder: folder_name")
+ * @param variant The DE variant.
  * @param random_generator The random number generator.
  */
 void example_experiment(const char *suite_name,
                         const char *suite_options,
                         const char *observer_name,
                         const char *observer_options,
+                        const de_variant_t *variant,
                         coco_random_state_t *random_generator) {
   size_t run;
   coco_suite_t *suite;
   coco_observer_t *observer;
   timing_data_t *timing_data;
+  problem_prefetcher_t *prefetcher;
+  coco_problem_t *problem;
   /* Initialize the suite and observer. */
   suite = coco_suite(suite_name, "", suite_options);
   observer = coco_observer(observer_name, observer_options);
   /* Initialize timing */
   timing_data = timing_data_initialize(suite);
+  /* The next problems are constructed while the current one runs */
+  prefetcher = problem_prefetcher_start(suite);
   /* Iterate over all problems in the suite */
-  while ((PROBLEM = coco_suite_get_next_problem(suite, observer)) != NULL) {
-    const char *function_name = coco_problem_get_name(PROBLEM);
-    char *short_function_name = get_short_function_number(function_name);
-    size_t dimension = coco_problem_get_dimension(PROBLEM);
+  while ((problem = problem_prefetcher_next(prefetcher, observer)) != NULL) {
+    const char *function_name;
+    char *short_function_name;
+    size_t dimension = coco_problem_get_dimension(problem);
+
+    ALLOC_PHASE(ALLOC_PHASE_SETUP);
+    function_name = coco_problem_get_name(problem);
+    short_function_name = get_short_function_number(function_name);
 
     //filename select
     char titlestr[128] = "./output/";
@@ -336,58 +1233,36 @@ void example_experiment(const char *suite_name,
       strcat(titlestr,"ga/");
     }
     strcat(titlestr,short_function_name);
+    free(short_function_name);
     sprintf(num, "/%ld", dimension);
     strcat(titlestr,num);
-    if(ENCODING == 0){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/L-");
-      }
-      else{
-        strcat(titlestr,"d/B-");
-      }
-    }
-    else if(ENCODING == 1){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/U-Lf-");
-      }
-      else if(APPROACH == 1){
-        strcat(titlestr,"d/U-Lm-");
-      }
-      else if(APPROACH == 2){
-        strcat(titlestr,"d/U-Lb-");
-      }
-      else if(APPROACH == 3){
-        strcat(titlestr,"d/U-B-");
-      }
-    }
-    else if(ENCODING == 2){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/U2-L-");
-      }
-      else{
-        strcat(titlestr,"d/U2-B-");
-      }
-    }
+    strcat(titlestr,"d/");
+    strcat(titlestr,variant->name);
+    strcat(titlestr,"-");
     sprintf(num, "%d", instance_cnt);
     strcat(titlestr,num);
     strcat(titlestr,".txt");
+    trajectory_begin(titlestr, dimension);
     /* Run the algorithm at least once */
     for (run = 1; run <= 1 + INDEPENDENT_RESTARTS; run++) {
-      long evaluations_done = (long) (coco_problem_get_evaluations(PROBLEM) + coco_problem_get_evaluations_constraints(PROBLEM));
+      long evaluations_done = (long) (coco_problem_get_evaluations(problem) + coco_problem_get_evaluations_constraints(problem));
       long evaluations_remaining = (long) (dimension * BUDGET_MULTIPLIER) - evaluations_done;
 
       /* Break the loop if the target was hit or there are no more remaining evaluations */
-      if ((coco_problem_final_target_hit(PROBLEM) && coco_problem_get_number_of_constraints(PROBLEM) == 0) || (evaluations_remaining <= 0))
+      if ((coco_problem_final_target_hit(problem) && coco_problem_get_number_of_constraints(problem) == 0) || (evaluations_remaining <= 0))
         break;
 
       /* Call the optimization algorithm for the remaining number of evaluations */
       if(ALGORITHM == 0){
         de_nopcm(evaluate_function,
+                        problem,
                         dimension,
-                        coco_problem_get_number_of_objectives(PROBLEM),
-                        coco_problem_get_smallest_values_of_interest(PROBLEM),
-                        coco_problem_get_largest_values_of_interest(PROBLEM),
+                        coco_problem_get_number_of_objectives(problem),
+                        coco_problem_get_number_of_integer_variables(problem),
+                        coco_problem_get_smallest_values_of_interest(problem),
+                        coco_problem_get_largest_values_of_interest(problem),
                         (size_t) evaluations_remaining,
+                        variant,
                         random_generator,
                         titlestr);
       }
@@ -396,17 +1271,23 @@ void example_experiment(const char *suite_name,
       }
 
       /* Break the loop if the algorithm performed no evaluations or an unexpected thing happened */
-      if (coco_problem_get_evaluations(PROBLEM) == evaluations_done) {
+      if (coco_problem_get_evaluations(problem) == evaluations_done) {
         printf("WARNING: Budget has not been exhausted (%lu/%lu evaluations done)!\n",
             (unsigned long) evaluations_done, (unsigned long) dimension * BUDGET_MULTIPLIER);
         break;
       }
-      else if (coco_problem_get_evaluations(PROBLEM) < evaluations_done)
+      else if (coco_problem_get_evaluations(problem) < evaluations_done)
         coco_error("Something unexpected happened - function evaluations were decreased!");
     }
+    ALLOC_PHASE(ALLOC_PHASE_OUTPUT);
+    trajectory_end();
     /* Keep track of time */
-    timing_data_time_problem(timing_data, PROBLEM);
+    timing_data_time_problem(timing_data, problem);
+    /* The problems are not owned by the suite, freeing one closes its observer files */
+    coco_problem_free(problem);
   }
+  ALLOC_PHASE(ALLOC_PHASE_STARTUP);
+  problem_prefetcher_stop(prefetcher);
 
   /* Output and finalize the timing data */
   timing_data_finalize(timing_data);
@@ -415,1093 +1296,3798 @@ void example_experiment(const char *suite_name,
   coco_suite_free(suite);
 }
 
+//COCO_PARTITIONS
 /**
- * A simple example of benchmarking random search on a given suite with default instances
- * that can serve also as a timing experiment.
- *
- * @param suite_name Name of the suite (e.g. "bbob" or "bbob-biobj").
- * @param suite_options Options of the suite (e.g. "dimensions: 2,3,5,10,20 instance_indices: 1-5").
- * @param observer_name Name of the observer matching with the chosen suite (e.g. "bbob-biobj"
- * when using the "bbob-biobj-ext" suite).
- * @param observer_options Options of the observer (e.g. "result_folder: folder_name")
- * @param random_generator The random number generator
+ * Moves the files of the result folder source into destination, creating its subdirectories as
+ * needed, and removes source. Two partitions never write the same file, so an existing file is an
+ * error.
  */
-void my_example_experiment(const char *file_name,
-                        coco_random_state_t *random_generator) {
-  FILE *fp;
-  printf("generating problem...\n");
-  MY_PROBLEM *my_problem = init_problem(random_generator);
-  printf("success generation\n");
-  // for(size_t i = 0; i < NUMBER_OF_PROBLEM; i++){
-  //   printf("%s:dimension%ld:instance%ld:range[0,%.0f]\n",my_problem[i].function_name, my_problem[i].dimension, my_problem[i].instance, my_problem[i].largest[0]);
-  //   printf("optimal solution:");
-  //   for(size_t j = 0; j < my_problem[i].dimension; j++){
-  //     printf("%lf ", my_problem[i].optimal[j]);
-  //   }
-  //   printf("\n");
-  //   printf("target hit result:\n");
-  //   for(size_t j = 0; j < NUMBER_OF_TARGET; j++){
-  //     printf("%.2e:%d\n", target[j], my_problem[i].evaluate_result[j]);
-  //   }
-  // }
-  /* Iterate over all problems in the suite */
-  for(size_t i = 0; i < NUMBER_OF_PROBLEM; i++){
-    const char *function_name = my_problem[i].function_name;
-    size_t dimension = my_problem[i].dimension;
-    double amount = 0;
-    size_t target_count = 0;
-    //filename select
-    char titlestr[128] = "./output/";
-    char num[30] = "";
-    if(ALGORITHM == 0){
-      strcat(titlestr,"de/");
+static void merge_result_folder(const char *source, const char *destination) {
+  DIR *dir;
+  struct dirent *entry;
+  char source_path[RESULT_PATH_LENGTH], destination_path[RESULT_PATH_LENGTH];
+  struct stat st;
+
+  if (mkdir(destination, 0755) != 0 && errno != EEXIST) {
+    fprintf(stderr, "Cannot create %s: %s\n", destination, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  dir = opendir(source);
+  if (dir == NULL) {
+    fprintf(stderr, "Cannot open %s: %s\n", source, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  while ((entry = readdir(dir)) != NULL) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+      continue;
     }
-    else if(ALGORITHM == 1){
-      strcat(titlestr,"ga/");
+    if (snprintf(source_path, sizeof(source_path), "%s/%s", source, entry->d_name) >= (int)sizeof(source_path)
+        || snprintf(destination_path, sizeof(destination_path), "%s/%s", destination, entry->d_name) >= (int)sizeof(destination_path)) {
+      fprintf(stderr, "Path too long in %s.\n", source);
+      exit(EXIT_FAILURE);
     }
-    strcat(titlestr,function_name);
-    sprintf(num, "/%d", (int)my_problem[i].r);
-    strcat(titlestr,num);
-    if((int)my_problem[i].largest[0] == 1){
-      sprintf(num, "/6/");
+    if (lstat(source_path, &st) != 0) {
+      fprintf(stderr, "Cannot stat %s: %s\n", source_path, strerror(errno));
+      exit(EXIT_FAILURE);
     }
-    else{
-      sprintf(num, "/%d/", (int)my_problem[i].largest[0]);
+    if (S_ISDIR(st.st_mode)) {
+      merge_result_folder(source_path, destination_path);
     }
-    strcat(titlestr,num);
-    sprintf(num, "%ld", dimension);
-    strcat(titlestr,num);
-    if(ENCODING == 0){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/L-");
-      }
-      else{
-        strcat(titlestr,"d/B-");
-      }
+    else if (access(destination_path, F_OK) == 0) {
+      fprintf(stderr, "Partitions wrote the same file %s.\n", destination_path);
+      exit(EXIT_FAILURE);
     }
-    else if(ENCODING == 1){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/U-Lf-");
-      }
-      else if(APPROACH == 1){
-        strcat(titlestr,"d/U-Lm-");
-      }
-      else if(APPROACH == 2){
-        strcat(titlestr,"d/U-Lb-");
-      }
-      else if(APPROACH == 3){
-        strcat(titlestr,"d/U-B-");
-      }
+    else if (rename(source_path, destination_path) != 0) {
+      fprintf(stderr, "Cannot move %s to %s: %s\n", source_path, destination_path, strerror(errno));
+      exit(EXIT_FAILURE);
     }
-    else if(ENCODING == 2){
-      if(APPROACH == 0){
-        strcat(titlestr,"d/U2-L-");
-      }
-      else{
-        strcat(titlestr,"d/U2-B-");
-      }
+  }
+  closedir(dir);
+  if (rmdir(source) != 0) {
+    fprintf(stderr, "Cannot remove %s: %s\n", source, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * Runs example_experiment with the functions of the suite split round-robin over launcher_workers
+ * partitions (--workers, 0: one per usable CPU). The COCO loggers keep their state in globals and
+ * allow one open logger per process, so every partition is a child process with its own suite,
+ * observer and result folder exdata/<result_folder>-part<w>-<pid>, pinned to one CPU. Each function
+ * is in one partition only, so the partitions write disjoint bbobexp_f<n>.info files and data_f<n>
+ * folders, which are merged into exdata/<result_folder> (with a -001, -002, ... suffix if it exists,
+ * like the COCO logger) once all partitions are done. The children start from the state of
+ * random_generator, so one partition gives the results of example_experiment.
+ *
+ * @param suite_name Name of the suite (e.g. "bbob-mixint").
+ * @param suite_options Options of the suite, without function_indices.
+ * @param observer_name Name of the observer matching with the chosen suite.
+ * @param result_folder Name of the merged result folder in exdata.
+ * @param variant The DE variant.
+ * @param random_generator The random number generator.
+ */
+void example_experiment_partitioned(const char *suite_name,
+                                    const char *suite_options,
+                                    const char *observer_name,
+                                    const char *result_folder,
+                                    const de_variant_t *variant,
+                                    coco_random_state_t *random_generator) {
+  numa_topology_t topology = numa_topology_discover();
+  size_t number_of_partitions = launcher_workers > 0 ? (size_t)launcher_workers : topology.number_of_cpus;
+  size_t number_of_functions, function_idx, dimension_idx, instance_idx;
+  pid_t pids[MAX_WORKERS];
+  char part_folders[MAX_WORKERS][RESULT_PATH_LENGTH];
+  char merged_folder[RESULT_PATH_LENGTH];
+  int trajectory = trajectory_logger != NULL;
+  int failed = 0;
+  coco_suite_t *suite;
+
+  /* The functions are numbered in suite order, the last problem has the last function */
+  suite = coco_suite(suite_name, "", suite_options);
+  coco_suite_decode_problem_index(suite, coco_suite_get_number_of_problems(suite) - 1,
+                                  &function_idx, &dimension_idx, &instance_idx);
+  coco_suite_free(suite);
+  number_of_functions = function_idx + 1;
+  if (number_of_partitions > number_of_functions) {
+    number_of_partitions = number_of_functions;
+  }
+  if (number_of_partitions > MAX_WORKERS) {
+    fprintf(stderr, "Too many workers (at most %d).\n", MAX_WORKERS);
+    exit(EXIT_FAILURE);
+  }
+  printf("Running %lu functions in %lu partitions\n", (unsigned long)number_of_functions,
+         (unsigned long)number_of_partitions);
+
+  /* The writer thread of the trajectory logger is not inherited by fork, every child starts its own */
+  trajectory_logger_stop();
+  fflush(stdout);
+  fflush(stderr);
+  for (size_t w = 0; w < number_of_partitions; w++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      fprintf(stderr, "Cannot start partition %lu: %s\n", (unsigned long)w, strerror(errno));
+      exit(EXIT_FAILURE);
     }
-    sprintf(num, "%ld", my_problem[i].instance);
-    strcat(titlestr,num);
-    strcat(titlestr,".txt");
-    //printf("%s\n",titlestr);
-    /* Run the algorithm at least once */
-    for (size_t run = 1; run <= 1 + INDEPENDENT_RESTARTS; run++) {
-      long evaluations_done = my_problem[i].evaluation_cnt;
-      long evaluations_remaining = (long) (dimension * BUDGET_MULTIPLIER) - evaluations_done;
-      /* Break the loop if the target was hit or there are no more remaining evaluations */
-      if((evaluations_remaining <= 0)){
-        break;
+    if (pid == 0) {
+      char options[4096], observer_options[RESULT_PATH_LENGTH + 32];
+      size_t length;
+      cpu_set_t cpu;
+
+      CPU_ZERO(&cpu);
+      CPU_SET((size_t)topology.cpus[w % topology.number_of_cpus], &cpu);
+      if (sched_setaffinity(0, sizeof(cpu), &cpu) != 0) {
+        fprintf(stderr, "Cannot pin partition %lu: %s\n", (unsigned long)w, strerror(errno));
       }
-      // if(my_problem[i].dimension != 5 && my_problem[i].function_name != "f13"){
-      //   break;
-      // }
-      /* Call the optimization algorithm for the remaining number of evaluations */
-      if(ALGORITHM == 0){
-        my_de_nopcm(function_name,
-                        dimension,
-                        1,
-                        my_problem[i].smallest,
-                        my_problem[i].largest,
-                        (size_t) evaluations_remaining,
-                        random_generator,
-                        titlestr,
-                        &my_problem[i]);
+      length = (size_t)snprintf(options, sizeof(options), "%s function_indices: ", suite_options);
+      for (size_t f = w; f < number_of_functions && length < sizeof(options); f += number_of_partitions) {
+        length += (size_t)snprintf(options + length, sizeof(options) - length, f == w ? "%lu" : ",%lu",
+                                   (unsigned long)(f + 1));
       }
-      else if(ALGORITHM == 1){
-
+      snprintf(observer_options, sizeof(observer_options), "result_folder: %s-part%lu-%ld",
+               result_folder, (unsigned long)w, (long)getpid());
+      if (trajectory) {
+        trajectory_logger_start();
       }
+      example_experiment(suite_name, options, observer_name, observer_options, variant, random_generator);
+      trajectory_logger_stop();
+      fflush(stdout);
+      _exit(EXIT_SUCCESS);
     }
-    // if(my_problem[i].dimension == 5 && strcmp(my_problem[i].function_name, "f13") == 0){
-     // printf("%s:dimension%ld:instance%ld:range[0,%.0f]:integer ratio%ld/5\n",my_problem[i].function_name, dimension, my_problem[i].instance, my_problem[i].largest[0], my_problem[i].r);
-    //   printf("optimal solution:");
-    //   for(size_t j = 0; j < dimension; j++){
-    //     printf("%lf ", my_problem[i].optimal[j]);
-    //   }
-    //   printf("\n");
-
-    //   printf("best solution   :");
-    //   for(size_t j = 0; j < dimension; j++){
-    //     printf("%lf ", my_problem[i].best_solution[j]);
-    //   }
-    //   printf("\n");
-
-      fp = fopen(titlestr, "w");
-      while(1){
-        if(amount > 4){
-          break;
-        }
-        for(int k = 0; k < NUMBER_OF_TARGET; k++){
-          if(((double)dimension*pow(10, amount) >= (double)(double)my_problem[i].evaluate_result[k] ) && (my_problem[i].evaluate_result[k] != -1)){
-            target_count++;
-          }
-          else{
-            break;
-          }
-        }
-        fprintf(fp,"%f %ld\n", amount, target_count);
-        target_count = 0;
-        amount += 0.001;
+    pids[w] = pid;
+    snprintf(part_folders[w], sizeof(part_folders[w]), "exdata/%s-part%lu-%ld",
+             result_folder, (unsigned long)w, (long)pid);
+  }
+  for (size_t w = 0; w < number_of_partitions; w++) {
+    int status;
+    while (waitpid(pids[w], &status, 0) < 0) {
+      if (errno != EINTR) {
+        fprintf(stderr, "Cannot wait for partition %lu: %s\n", (unsigned long)w, strerror(errno));
+        exit(EXIT_FAILURE);
       }
-      fclose(fp);
-    //}
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+      fprintf(stderr, "Partition %lu failed.\n", (unsigned long)w);
+      failed = 1;
+    }
   }
-  for (size_t i = 0; i < NUMBER_OF_PROBLEM; i++) {
-    free_problem(&my_problem[i]);
+  coco_free_memory(topology.cpus);
+  if (failed) {
+    fprintf(stderr, "The partitions are kept in exdata and not merged.\n");
+    exit(EXIT_FAILURE);
+  }
+  if (trajectory) {
+    trajectory_logger_start();
   }
-  free(my_problem);  // 問題配列自体の解放
-}
 
-// MyCOCO
-void free_problem(MY_PROBLEM* problem) {
-    // function_name のメモリ解放
-    if (problem->function_name) {
-        free(problem->function_name);
+  /* Merge the partitions into a new folder */
+  snprintf(merged_folder, sizeof(merged_folder), "exdata/%s", result_folder);
+  for (int k = 1; access(merged_folder, F_OK) == 0; k++) {
+    if (k > 999) {
+      fprintf(stderr, "Cannot find a free result folder for %s.\n", result_folder);
+      exit(EXIT_FAILURE);
     }
+    snprintf(merged_folder, sizeof(merged_folder), "exdata/%s-%03d", result_folder, k);
+  }
+  for (size_t w = 0; w < number_of_partitions; w++) {
+    merge_result_folder(part_folders[w], merged_folder);
+  }
+  printf("Merged the partitions into %s\n", merged_folder);
+}
 
-    // smallest 配列のメモリ解放
-    if (problem->smallest) {
-        free(problem->smallest);
+//PROBLEM_PREFETCH
+/**
+ * Returns the problem with the next suite index after index, or NULL; the suite indices follow
+ * the order of coco_suite_get_next_problem (instances, then functions, then dimensions). Indices
+ * excluded by the suite options give no problem and are skipped.
+ */
+static coco_problem_t *problem_prefetcher_construct(problem_prefetcher_t *prefetcher, size_t *index) {
+  while (*index < prefetcher->number_of_problems) {
+    coco_problem_t *problem = coco_suite_get_problem(prefetcher->suite, (*index)++);
+    if (problem != NULL) {
+      return problem;
     }
+  }
+  return NULL;
+}
 
-    // largest 配列のメモリ解放
-    if (problem->largest) {
-        free(problem->largest);
-    }
+static void *problem_prefetcher_run(void *arg) {
+  problem_prefetcher_t *prefetcher = (problem_prefetcher_t *)arg;
+  size_t index = 0;
 
-    // optimal 配列のメモリ解放
-    if (problem->optimal) {
-        free(problem->optimal);
+  for (;;) {
+    coco_problem_t *problem;
+    pthread_mutex_lock(&prefetcher->mutex);
+    while (prefetcher->count == COCO_PREFETCH_DEPTH && !prefetcher->stop) {
+      pthread_cond_wait(&prefetcher->changed, &prefetcher->mutex);
     }
+    if (prefetcher->stop) {
+      pthread_mutex_unlock(&prefetcher->mutex);
+      break;
+    }
+    pthread_mutex_unlock(&prefetcher->mutex);
 
-    // best_solution 配列のメモリ解放
-    if (problem->best_solution) {
-        free(problem->best_solution);
+    /* constructed outside of the lock, while the consumer runs the current problem */
+    problem = problem_prefetcher_construct(prefetcher, &index);
+
+    pthread_mutex_lock(&prefetcher->mutex);
+    if (problem == NULL) {
+      prefetcher->done = 1;
+    }
+    else {
+      prefetcher->slots[(prefetcher->head + prefetcher->count) % PREFETCH_SLOTS] = problem;
+      prefetcher->count++;
+    }
+    pthread_cond_broadcast(&prefetcher->changed);
+    pthread_mutex_unlock(&prefetcher->mutex);
+    if (problem == NULL) {
+      break;
     }
+  }
+  return NULL;
 }
 
-MY_PROBLEM* init_problem(coco_random_state_t *random_generator){
-  MY_PROBLEM* problems = (MY_PROBLEM*)malloc( NUMBER_OF_PROBLEM * sizeof(MY_PROBLEM));
-  if (!problems) {
-      fprintf(stderr, "Memory allocation failed for MY_PROBLEM.\n");
+problem_prefetcher_t *problem_prefetcher_start(coco_suite_t *suite) {
+  problem_prefetcher_t *prefetcher = (problem_prefetcher_t *)coco_allocate_memory(sizeof(*prefetcher));
+
+  prefetcher->suite = suite;
+  prefetcher->number_of_problems = coco_suite_get_number_of_problems(suite);
+  prefetcher->head = 0;
+  prefetcher->count = 0;
+  prefetcher->next_index = 0;
+  prefetcher->done = 0;
+  prefetcher->stop = 0;
+  if (COCO_PREFETCH_DEPTH > 0) {
+    pthread_mutex_init(&prefetcher->mutex, NULL);
+    pthread_cond_init(&prefetcher->changed, NULL);
+    if (pthread_create(&prefetcher->thread, NULL, problem_prefetcher_run, prefetcher) != 0) {
+      fprintf(stderr, "Cannot create the problem prefetch thread.\n");
       exit(EXIT_FAILURE);
+    }
   }
+  return prefetcher;
+}
 
-  // 各問題を初期化(func)
-  char *function[] = {"f1", "f3", "f8"};
-  size_t dimension[] = {5, 10, 20, 40, 80, 160};
-  double range[] = {2, 3, 4, 5, 6, 7, 8, 9, 10};
-  double coco_range[] = {1, 3, 7, 15};
-  int problem_cnt = 0;
-  double amount = -2;
-  for(size_t func_cnt = 0; func_cnt < sizeof(function) / sizeof(function[0]); func_cnt++){
-    for(size_t r_cnt = 1; r_cnt < 5; r_cnt++){
-      for(size_t range_cnt = 0; range_cnt < sizeof(range) / sizeof(range[0]); range_cnt++){
-        for(size_t dimension_cnt = 0; dimension_cnt < sizeof(dimension) / sizeof(dimension[0]); dimension_cnt++){
-          for (size_t instance_count = 0; instance_count < 15; instance_count++){
-            problems[problem_cnt].function_name = (char*)malloc(strlen(function[func_cnt]) + 1);
-            if (!problems[problem_cnt].function_name) {
-                fprintf(stderr, "Memory allocation failed for function_name.\n");
-                exit(EXIT_FAILURE);
-            }
-            strcpy(problems[problem_cnt].function_name, function[func_cnt]);
-
-            problems[problem_cnt].dimension = dimension[dimension_cnt];
-            problems[problem_cnt].instance = instance_count;
-            problems[problem_cnt].evaluation_cnt = 0;
-            problems[problem_cnt].end_flag = 0;
-            problems[problem_cnt].r = r_cnt;
-            for(size_t i = 0; i < NUMBER_OF_TARGET; i++){
-              problems[problem_cnt].evaluate_result[i] = -1;
-            }
-            // optimalとsmallest と largest のメモリを確保
-            problems[problem_cnt].smallest = (double*)malloc(dimension[dimension_cnt] * sizeof(double));
-            problems[problem_cnt].largest = (double*)malloc(dimension[dimension_cnt] * sizeof(double));
-            problems[problem_cnt].optimal = (double*)malloc(dimension[dimension_cnt] * sizeof(double));
-            problems[problem_cnt].best_solution = (double*)malloc(dimension[dimension_cnt] * sizeof(double));
-            
-            if (!problems[problem_cnt].smallest || !problems[problem_cnt].largest) {
-              fprintf(stderr, "Memory allocation failed for arrays.\n");
-              exit(EXIT_FAILURE);
-            }
-            for(size_t i = 0; i < dimension[dimension_cnt]; i++){
-              problems[problem_cnt].best_solution[i] = 100;
-            }
+/**
+ * Returns the next problem of the suite with the observer added, or NULL after the last one. The
+ * caller frees the problem.
+ */
+coco_problem_t *problem_prefetcher_next(problem_prefetcher_t *prefetcher, coco_observer_t *observer) {
+  coco_problem_t *problem = NULL;
 
-            //if(range_cnt != 4){
-              // 配列を初期化
-              for (size_t j = 0; j < dimension[dimension_cnt]*r_cnt/5; j++) {
-                problems[problem_cnt].smallest[j] = 0;
-                problems[problem_cnt].largest[j] = range[range_cnt];
-                problems[problem_cnt].optimal[j] = (int)(coco_random_uniform(random_generator) * (problems[problem_cnt].largest[j] - problems[problem_cnt].smallest[j] + 1) + problems[problem_cnt].smallest[j]);
-              }
-              for (size_t j = dimension[dimension_cnt]*r_cnt/5; j < dimension[dimension_cnt]; j++) {
-                problems[problem_cnt].smallest[j] = -5;
-                problems[problem_cnt].largest[j] = 5;
-                problems[problem_cnt].optimal[j] = problems[problem_cnt].smallest[j] + coco_random_uniform(random_generator) * (problems[problem_cnt].largest[j] - problems[problem_cnt].smallest[j]);
-              }
-            // }
-            // else{
-            //   // 配列を初期化
-            //   for (size_t m = 0; m < 4; m++) {
-            //     for (size_t j = m*dimension[dimension_cnt]/5; j < (m + 1)*dimension[dimension_cnt]/5; j++) {
-            //       problems[problem_cnt].smallest[j] = 0;
-            //       problems[problem_cnt].largest[j] = coco_range[m];
-            //       problems[problem_cnt].optimal[j] = (int)(coco_random_uniform(random_generator) * (problems[problem_cnt].largest[j] - problems[problem_cnt].smallest[j] + 1) + problems[problem_cnt].smallest[j]);
-            //     }
-            //   }
-            //   for (size_t j = 4*dimension[dimension_cnt]/5; j < (4 + 1)*dimension[dimension_cnt]/5; j++) {
-            //     problems[problem_cnt].smallest[j] = -5;
-            //     problems[problem_cnt].largest[j] = 5;
-            //     problems[problem_cnt].optimal[j] = problems[problem_cnt].smallest[j] + coco_random_uniform(random_generator) * (problems[problem_cnt].largest[j] - problems[problem_cnt].smallest[j]);
-            //   }
-            // }
-
-            problem_cnt++;
-          }
-        }
-      }
+  if (COCO_PREFETCH_DEPTH == 0) {
+    problem = problem_prefetcher_construct(prefetcher, &prefetcher->next_index);
+  }
+  else {
+    pthread_mutex_lock(&prefetcher->mutex);
+    while (prefetcher->count == 0 && !prefetcher->done) {
+      pthread_cond_wait(&prefetcher->changed, &prefetcher->mutex);
+    }
+    if (prefetcher->count > 0) {
+      problem = prefetcher->slots[prefetcher->head];
+      prefetcher->head = (prefetcher->head + 1) % PREFETCH_SLOTS;
+      prefetcher->count--;
+      pthread_cond_broadcast(&prefetcher->changed);
     }
+    pthread_mutex_unlock(&prefetcher->mutex);
   }
-  for(int target_cnt = 0; target_cnt < NUMBER_OF_TARGET; target_cnt++){
-    target[target_cnt] = pow(10, -amount);
-    amount += 0.2;
+  if (problem == NULL) {
+    return NULL;
   }
+  return coco_problem_add_observer(problem, observer);
+}
 
-  return problems;
+/**
+ * Stops the prefetch thread and frees the problems it constructed but were not taken.
+ */
+void problem_prefetcher_stop(problem_prefetcher_t *prefetcher) {
+  if (COCO_PREFETCH_DEPTH > 0) {
+    pthread_mutex_lock(&prefetcher->mutex);
+    prefetcher->stop = 1;
+    pthread_cond_broadcast(&prefetcher->changed);
+    pthread_mutex_unlock(&prefetcher->mutex);
+    pthread_join(prefetcher->thread, NULL);
+    while (prefetcher->count > 0) {
+      coco_problem_free(prefetcher->slots[prefetcher->head]);
+      prefetcher->head = (prefetcher->head + 1) % PREFETCH_SLOTS;
+      prefetcher->count--;
+    }
+    pthread_cond_destroy(&prefetcher->changed);
+    pthread_mutex_destroy(&prefetcher->mutex);
+  }
+  coco_free_memory(prefetcher);
 }
 
-//EA_DEFAULT_PARTS
-void ea_group_initialization(double** population, size_t dimension, const double* lower_bounds, const double* upper_bounds, coco_random_state_t *random_generator){
-  //initialization
-  for (int i = 0; i < DE_N; i++) {
-    for (int j = 0; j < dimension; j++) {
-      if(ENCODING == 0){
-        double range = upper_bounds[j] - lower_bounds[j];
-        population[i][j] = lower_bounds[j] + coco_random_uniform(random_generator) * range;
-      }
-      else if(ENCODING == 1){
-        population[i][j] = coco_random_uniform(random_generator);
+/**
+ * A simple example of benchmarking random search on a given suite with default instances
+ * that can serve also as a timing experiment.
+ *
+ * @param suite_name Name of the suite (e.g. "bbob" or "bbob-biobj").
+ * @param suite_options Options of the suite (e.g. "dimensions: 2,3,5,10,20 instance_indices: 1-5").
+ * @param observer_name Name of the observer matching with the chosen suite (e.g. "bbob-biobj"
+ * when using the "bbob-biobj-ext" suite).
+ * @param observer_options Options of the observer (e.g. "result_folder: folder_name")
+ * @param variant The DE variant.
+ * @param random_generator The random number generator
+ */
+void my_example_experiment(const char *file_name,
+                        const de_variant_t *variant,
+                        coco_random_state_t *random_generator) {
+  FILE *runtime_file = NULL;
+  size_t number_of_problem;
+  MY_PROBLEM *my_problem = load_problems(random_generator, &number_of_problem);
+  // for(size_t i = 0; i < NUMBER_OF_PROBLEM; i++){
+  //   printf("%s:dimension%ld:instance%ld:range[0,%.0f]\n",my_problem[i].function_name, my_problem[i].dimension, my_problem[i].instance, my_problem[i].largest[0]);
+  //   printf("optimal solution:");
+  //   for(size_t j = 0; j < my_problem[i].dimension; j++){
+  //     printf("%lf ", my_problem[i].optimal[j]);
+  //   }
+  //   printf("\n");
+  //   printf("target hit result:\n");
+  //   for(size_t j = 0; j < NUMBER_OF_TARGET; j++){
+  //     printf("%.2e:%d\n", target[j], my_problem[i].evaluate_result[j]);
+  //   }
+  // }
+  if(runtime_path != NULL){
+    runtime_file = open_runtimes(runtime_path);
+  }
+  /* Iterate over all problems in the suite */
+  for(size_t i = 0; i < number_of_problem; i++){
+    run_my_problem(&my_problem[i], variant, random_generator, runtime_file);
+  }
+  if(runtime_file != NULL && (ferror(runtime_file) || fclose(runtime_file) != 0)){
+    fprintf(stderr, "Cannot write runtimes %s.\n", runtime_path);
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < number_of_problem; i++) {
+    free_problem(&my_problem[i]);
+  }
+  free(my_problem);  // 問題配列自体の解放
+  close_catalog();
+}
+
+/**
+ * Runs the DE variant on one problem of the custom suite and writes its result file (and its
+ * runtime record if runtime_file is not NULL). Returns 0 if the campaign stopped before the
+ * problem was done (see campaign_stopping), which then has no results.
+ */
+int run_my_problem(MY_PROBLEM *problem,
+                   const de_variant_t *variant,
+                   coco_random_state_t *random_generator,
+                   FILE *runtime_file) {
+  my_problem_job_t job;
+  double **x;
+
+  my_problem_job_begin(&job, problem, variant, random_generator, runtime_file);
+  while ((x = my_problem_job_ask(&job)) != NULL) {
+    de_run_evaluate(job.run, x);
+    de_run_tell(job.run);
+  }
+  my_problem_job_end(&job);
+  return !job.aborted;
+}
+
+/**
+ * Starts the job of running the DE variant on one problem of the custom suite: prepares the
+ * problem and starts its trajectory. The runs of the job are advanced by my_problem_job_ask and
+ * de_run_tell, and my_problem_job_end writes the results.
+ */
+void my_problem_job_begin(my_problem_job_t *job,
+                          MY_PROBLEM *problem,
+                          const de_variant_t *variant,
+                          coco_random_state_t *random_generator,
+                          FILE *runtime_file) {
+  const char *function_name = problem->function_name;
+  size_t dimension = problem->dimension;
+  char *titlestr = job->titlestr;
+  char num[30] = "";
+
+  ALLOC_PHASE(ALLOC_PHASE_SETUP);
+  job->problem = problem;
+  job->variant = variant;
+  job->random_generator = random_generator;
+  job->runtime_file = runtime_file;
+  job->run = NULL;
+  job->aborted = 0;
+  job->trace = trace_file != NULL && problem->instance < TRACE_INSTANCES ? trace_buffer_new(dimension) : NULL;
+  job->number_of_runs = 0;
+  //filename select
+  strcpy(titlestr, "./output/");
+  if(ALGORITHM == 0){
+    strcat(titlestr,"de/");
+  }
+  else if(ALGORITHM == 1){
+    strcat(titlestr,"ga/");
+  }
+  strcat(titlestr,function_name);
+  sprintf(num, "/%d", (int)problem->r);
+  strcat(titlestr,num);
+  sprintf(num, "/%d/", my_problem_range(problem));
+  strcat(titlestr,num);
+  sprintf(num, "%ld", dimension);
+  strcat(titlestr,num);
+  strcat(titlestr,"d/");
+  strcat(titlestr,variant->name);
+  strcat(titlestr,"-");
+  sprintf(num, "%ld", problem->instance);
+  strcat(titlestr,num);
+  strcat(titlestr,".txt");
+  //printf("%s\n",titlestr);
+  my_problem_prepare(problem);
+  trajectory_begin(titlestr, dimension);
+}
+
+/**
+ * Returns the points whose values the current run of the job asks for (see de_run_ask). Once the
+ * run is done, the next one is started with the remaining budget; returns NULL when the budget is
+ * exhausted or no restart is left, or aborts the job and returns NULL when the campaign stops.
+ */
+double **my_problem_job_ask(my_problem_job_t *job) {
+  MY_PROBLEM *problem = job->problem;
+  double **x;
+
+  while (1) {
+    long evaluations_remaining;
+    if (campaign_stopping()) {
+      if (job->run != NULL) {
+        de_run_free(job->run);
+        job->run = NULL;
       }
-      else if(ENCODING == 2){
-        if(lower_bounds[j] == -5){
-          double range = upper_bounds[j] - lower_bounds[j];
-          population[i][j] = lower_bounds[j] + coco_random_uniform(random_generator) * range;
-        }
-        else{
-          double range = (upper_bounds[j] + 0.5 - FLT_EPSILON) - (lower_bounds[j] - 0.5);
-          population[i][j] = lower_bounds[j] - 0.5 + coco_random_uniform(random_generator) * range;
-        }
+      job->aborted = 1;
+      return NULL;
+    }
+    if (job->run != NULL) {
+      ALLOC_PHASE(ALLOC_PHASE_GENERATIONS);
+      if ((x = de_run_ask(job->run)) != NULL) {
+        return x;
       }
+      de_run_free(job->run);
+      job->run = NULL;
+    }
+    evaluations_remaining = (long) (problem->dimension * budget_multiplier) - problem->evaluation_cnt;
+    /* Stop if there are no more remaining evaluations or restarts */
+    if (ALGORITHM != 0 || job->number_of_runs == 1 + INDEPENDENT_RESTARTS || evaluations_remaining <= 0) {
+      return NULL;
     }
+    ALLOC_PHASE(ALLOC_PHASE_SETUP);
+    job->run = de_run_new(problem, (size_t) evaluations_remaining, job->variant, job->random_generator);
+    job->run->trace = job->trace;
+    job->number_of_runs++;
   }
 }
 
-void ea_group_encoding(double** x, double** tmp, size_t dimension, const double* lower_bounds, const double* upper_bounds){
-  if((ENCODING == 0 && APPROACH == 1) || (ENCODING == 1 && APPROACH == 3) || (ENCODING == 2 && APPROACH == 1)){
-    for (int i = 0; i < DE_N; i++) {
-      for(int j = 0; j < dimension; j++){
-        tmp[i][j] = x[i][j];
+/**
+ * Ends the trajectory of the problem of the job, writes its result file, its runtime record and
+ * its trace record unless the job was aborted, and releases the problem.
+ */
+void my_problem_job_end(my_problem_job_t *job) {
+  MY_PROBLEM *problem = job->problem;
+  FILE *fp;
+
+  ALLOC_PHASE(ALLOC_PHASE_OUTPUT);
+  trajectory_end();
+  if(job->aborted){
+    if(job->trace != NULL){
+      trace_buffer_free(job->trace);
+    }
+    my_problem_release(problem);
+    ALLOC_PHASE(ALLOC_PHASE_STARTUP);
+    return;
+  }
+  fp = fopen(job->titlestr, "w");
+  write_result_file(fp, problem);
+  fclose(fp);
+  if(job->runtime_file != NULL){
+    write_runtime_record(job->runtime_file, problem, job->variant);
+  }
+  if(job->trace != NULL){
+    trace_write(job->trace, problem, job->variant);
+    trace_buffer_free(job->trace);
+  }
+  my_problem_release(problem);
+  ALLOC_PHASE(ALLOC_PHASE_STARTUP);
+}
+
+/**
+ * Generates the problems of the custom suite, or maps them from the catalog (--catalog).
+ */
+MY_PROBLEM *load_problems(coco_random_state_t *random_generator, size_t *number_of_problem) {
+  MY_PROBLEM *my_problem;
+  ALLOC_PHASE(ALLOC_PHASE_CATALOG);
+  if(catalog_path != NULL){
+    my_problem = open_catalog(catalog_path, random_generator, number_of_problem);
+  }
+  else{
+    printf("generating problem...\n");
+    my_problem = init_problem(random_generator, number_of_problem);
+    printf("success generation\n");
+  }
+  ALLOC_PHASE(ALLOC_PHASE_STARTUP);
+  return my_problem;
+}
+
+//LAUNCHER
+/**
+ * Appends the CPUs of a cpulist ("0-3,8-11") that the process may run on to cpus.
+ */
+static size_t parse_cpulist(const char *list, const cpu_set_t *allowed, int *cpus, size_t number_of_cpus) {
+  const char *p = list;
+
+  while (*p != '\0' && *p != '\n') {
+    char *end;
+    long first = strtol(p, &end, 10), last;
+    if (end == p) {
+      break;
+    }
+    last = first;
+    if (*end == '-') {
+      p = end + 1;
+      last = strtol(p, &end, 10);
+    }
+    for (long cpu = first; cpu <= last; cpu++) {
+      if (cpu < CPU_SETSIZE && CPU_ISSET((size_t)cpu, allowed)) {
+        cpus[number_of_cpus++] = (int)cpu;
       }
     }
+    p = (*end == ',') ? end + 1 : end;
   }
-  for (int i = 0; i < DE_N; i++) {
-    if(ENCODING == 0 || ENCODING == 2){
-      if(APPROACH == 0){
-        round_vec(x[i],dimension,lower_bounds,upper_bounds);
-        for(int j = 0; j < dimension; j++){
-          tmp[i][j] = x[i][j];
-        }
+  return number_of_cpus;
+}
+
+/**
+ * Reads the NUMA nodes and their CPUs from /sys/devices/system/node, keeping the CPUs of the
+ * affinity mask of the process (so numactl and taskset still apply). Without NUMA information all
+ * usable CPUs form one node.
+ */
+numa_topology_t numa_topology_discover(void) {
+  numa_topology_t topology;
+  cpu_set_t allowed;
+  int *node_cpus[MAX_NUMA_NODES];
+  size_t node_size[MAX_NUMA_NODES];
+  size_t number_of_allowed;
+  char path[64], list[4096];
+
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    fprintf(stderr, "Cannot read the CPU affinity: %s\n", strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  number_of_allowed = (size_t)CPU_COUNT(&allowed);
+  topology.number_of_nodes = 0;
+  topology.number_of_cpus = 0;
+  topology.cpus = (int *)coco_allocate_memory(number_of_allowed * sizeof(int));
+  for (int node = 0; node < MAX_NUMA_NODES; node++) {
+    FILE *fp;
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    fp = fopen(path, "r");
+    if (fp == NULL) {
+      continue;
+    }
+    if (fgets(list, sizeof(list), fp) != NULL) {
+      int *cpus = (int *)coco_allocate_memory(CPU_SETSIZE * sizeof(int));
+      size_t size = parse_cpulist(list, &allowed, cpus, 0);
+      if (size > 0) {
+        node_cpus[topology.number_of_nodes] = cpus;
+        node_size[topology.number_of_nodes++] = size;
       }
-      else if(APPROACH == 1){
-        round_vec(tmp[i],dimension,lower_bounds,upper_bounds);
+      else {
+        coco_free_memory(cpus);
       }
     }
-    else{
-      if(APPROACH == 0 || APPROACH  == 1 || APPROACH  == 2){
-        new_round_vec(x[i], dimension, lower_bounds, upper_bounds);
-        for(int j = 0; j < dimension; j++){
-          tmp[i][j] = x[i][j];
-        }
-        decoding_vec(tmp[i], dimension, lower_bounds, upper_bounds);
+    fclose(fp);
+  }
+  if (topology.number_of_nodes == 0) {
+    node_cpus[0] = (int *)coco_allocate_memory(CPU_SETSIZE * sizeof(int));
+    node_size[0] = 0;
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        node_cpus[0][node_size[0]++] = (int)cpu;
       }
-      else{
-        decoding_vec(tmp[i], dimension, lower_bounds, upper_bounds);
+    }
+    topology.number_of_nodes = 1;
+  }
+  /* interleave the nodes: node 0 cpu 0, node 1 cpu 0, ..., node 0 cpu 1, ... */
+  for (size_t k = 0; topology.number_of_cpus < number_of_allowed; k++) {
+    size_t added = 0;
+    for (size_t node = 0; node < topology.number_of_nodes; node++) {
+      if (k < node_size[node]) {
+        topology.cpus[topology.number_of_cpus++] = node_cpus[node][k];
+        added++;
       }
     }
+    if (added == 0) {
+      break;
+    }
   }
+  for (size_t node = 0; node < topology.number_of_nodes; node++) {
+    coco_free_memory(node_cpus[node]);
+  }
+  return topology;
 }
 
-void round_vec(double *x, size_t dimention_size, const double *lower_bounds, const double *upper_bounds){
-  double y[40] = {0};
-  double y_star;
-  double min_dist = 0;
-  for(int i = 0; i < dimention_size; i++){
-    if(lower_bounds[i] != -5){
-      //補助値を計算
-      for(int  j = 0; j <= (int)upper_bounds[i]; j++){
-          y[j] = j;
-      }
-      //連続値に最も近い補助値 y^* を求める
-      min_dist = fabs(fabs(y[0]) - fabs(x[i]));
-      y_star = y[0];
+/**
+ * Copies the problem into the arena of the worker (4 * dimension doubles), so the worker reads its
+ * bounds and optimal point from memory of its own node, and resets the state of the run. The copy
+ * does not own its arrays.
+ */
+static void my_problem_localize(MY_PROBLEM *local, const MY_PROBLEM *problem, double *arena) {
+  const size_t dimension = problem->dimension;
+
+  *local = *problem;
+  local->smallest = arena;
+  local->largest = arena + dimension;
+  local->optimal = arena + 2 * dimension;
+  local->best_solution = arena + 3 * dimension;
+  memcpy(local->smallest, problem->smallest, dimension * sizeof(double));
+  memcpy(local->largest, problem->largest, dimension * sizeof(double));
+  memcpy(local->optimal, problem->optimal, dimension * sizeof(double));
+  for (size_t j = 0; j < dimension; j++) {
+    local->best_solution[j] = 100;
+  }
+  for (size_t j = 0; j < NUMBER_OF_TARGET; j++) {
+    local->evaluate_result[j] = -1;
+    local->first_hit[j] = -1;
+  }
+  local->evaluation_cnt = 0;
+  local->end_flag = 0;
+  local->integer_table = NULL;
+  local->table_evaluate = NULL;
+  local->mapped = 1;
+}
 
-      for (int j = 1; j <= (int)upper_bounds[i]; j++) {
-          double dist = fabs(fabs(y[j]) - fabs(x[i]));;
-          if (dist <= min_dist) {
-              min_dist = dist;
-              y_star = y[j];
-          }
-      }
-      x[i] = y_star;
+static double cost_seed(const MY_PROBLEM *problem) {
+  return (double)problem->dimension * (double)problem->dimension * budget_multiplier;
+}
+
+static cost_key_t *cost_model_find(cost_model_t *model, const char *function_name, const de_variant_t *variant, size_t dimension) {
+  for (size_t k = 0; k < model->number_of_keys; k++) {
+    cost_key_t *key = &model->keys[k];
+    if (key->variant == variant && key->dimension == dimension && strcmp(key->function_name, function_name) == 0) {
+      return key;
     }
   }
+  return NULL;
 }
 
-void new_round_vec(double *x, size_t dimention_size, const double *lower_bounds, const double *upper_bounds){
-  double y[40]= {0};
+static void cost_model_add(cost_model_t *model, const char *function_name, const de_variant_t *variant, size_t dimension, double seed, double seconds) {
+  cost_key_t *key = cost_model_find(model, function_name, variant, dimension);
 
-  for(int i = 0; i < dimention_size; i++){
-    if(lower_bounds[i] != -5){
-      // 補助値を計算
-      for(int j = 0; j <= (int)upper_bounds[i] + 1; j++){
-        y[j] = 1/(upper_bounds[i] + 1) * j;
-      }
+  if (key == NULL) {
+    if (model->number_of_keys == MAX_COST_KEYS || strlen(function_name) >= CATALOG_FUNCTION_NAME_LENGTH) {
+      return;
+    }
+    key = &model->keys[model->number_of_keys++];
+    strcpy(key->function_name, function_name);
+    key->variant = variant;
+    key->dimension = dimension;
+    key->seconds = 0;
+    key->seed = 0;
+    key->count = 0;
+  }
+  key->seconds += seconds;
+  key->seed += seed;
+  key->count++;
+  model->seconds += seconds;
+  model->seed += seed;
+}
 
-      //整数型の丸め
-      if(APPROACH == 0){//U-Lf
-        for(int j = 1; j <= (int)upper_bounds[i] + 1; j++){
-          if(x[i] < y[j]){
-            if(j == 1){
-              x[i] = 0;
-            }
-            else if(j == (int)upper_bounds[i] + 1){
-              x[i] = 1;
-            }
-            else{
-              x[i] = y[j - 1] + 1/((upper_bounds[i] + 1)*2);
-            }
-            break;
-          }
-        }
+/**
+ * Reads the timing report of a previous run (see write_timing_report) if there is one.
+ */
+static void cost_model_load(cost_model_t *model, const char *path) {
+  char line[256], function_name[CATALOG_FUNCTION_NAME_LENGTH], variant_name[RUNTIME_VARIANT_LENGTH];
+  unsigned long dimension;
+  double seconds;
+  FILE *fp;
+
+  model->number_of_keys = 0;
+  model->seconds = 0;
+  model->seed = 0;
+  if (path == NULL || (fp = fopen(path, "r")) == NULL) {
+    return;
+  }
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    MY_PROBLEM problem;
+    if (line[0] == '#' || sscanf(line, "%31s %15s %lu %*u %*u %*u %lf", function_name, variant_name, &dimension, &seconds) != 4) {
+      continue;
+    }
+    problem.dimension = (size_t)dimension;
+    /* the configurations of an earlier --sweep are unknown (NULL) and only scale their function */
+    cost_model_add(model, function_name, lookup_de_variant(variant_name), problem.dimension, cost_seed(&problem), seconds);
+  }
+  fclose(fp);
+  printf("cost model: %lu timed classes from %s\n", (unsigned long)model->number_of_keys, path);
+}
+
+static double cost_model_predict(cost_model_t *model, const MY_PROBLEM *problem, const de_variant_t *variant) {
+  const double seed = cost_seed(problem);
+  const cost_key_t *key = cost_model_find(model, problem->function_name, variant, problem->dimension);
+  double seconds = 0, seeds = 0;
+
+  if (key != NULL) {
+    return key->seconds / (double)key->count;
+  }
+  for (size_t k = 0; k < model->number_of_keys; k++) {
+    if (strcmp(model->keys[k].function_name, problem->function_name) == 0) {
+      seconds += model->keys[k].seconds;
+      seeds += model->keys[k].seed;
+    }
+  }
+  if (seeds > 0) {
+    return seed * seconds / seeds;
+  }
+  if (model->seed > 0) {
+    return seed * model->seconds / model->seed;
+  }
+  return seed;
+}
+
+typedef struct cost_order{
+  double cost;
+  size_t item;
+}cost_order_t;
+
+static int compare_cost_order(const void *a, const void *b) {
+  const cost_order_t *ca = (const cost_order_t *)a;
+  const cost_order_t *cb = (const cost_order_t *)b;
+  if (ca->cost != cb->cost) {
+    return ca->cost > cb->cost ? -1 : 1;
+  }
+  return ca->item < cb->item ? -1 : (ca->item > cb->item ? 1 : 0);
+}
+
+/**
+ * Measures the evaluations per second of the DE on the (function, variant, dimension) classes of
+ * the work items that the cost model has no time for. The share of integer variables drives the
+ * cost, so the variant is run on a copy of the first problem of every r of the class, for
+ * PLAN_CALIBRATION_SECONDS and restarted as needed, and the time of preparing the problem, a full
+ * budget at that rate and writing a result file is added to the class. Runs that hit the final
+ * target end early, so the times are upper bounds. The mean time of preparing and writing (to
+ * PLAN_SCRATCH_PATH, on the file system of the results) is kept as the overhead of the launcher,
+ * which the budget does not scale.
+ */
+static void plan_benchmark(launcher_t *launcher, cost_model_t *model) {
+  const size_t number_of_timed = model->number_of_keys;
+  double *arena = coco_allocate_vector(4 * launcher->max_dimension);
+  const MY_PROBLEM *first = NULL;
+  size_t number_of_settings = 0;
+
+  launcher->overhead = 0;
+  for (size_t i = 0; i < launcher->number_of_problem; i++) {
+    const MY_PROBLEM *problem = &launcher->problems[i];
+    if (first == NULL || strcmp(problem->function_name, first->function_name) != 0) {
+      first = problem;
+    }
+    /* the first range and instance stand for the other ones */
+    if (problem->instance != first->instance || my_problem_range(problem) != my_problem_range(first)) {
+      continue;
+    }
+    for (size_t v = 0; v < launcher->number_of_variants; v++) {
+      const de_variant_t *variant = launcher->variants[v];
+      const size_t budget = problem->dimension * budget_multiplier;
+      const cost_key_t *key = cost_model_find(model, problem->function_name, variant, problem->dimension);
+      const int timed = key != NULL && (size_t)(key - model->keys) < number_of_timed;
+      coco_random_state_t *random_generator;
+      de_run_t *run = NULL;
+      MY_PROBLEM local;
+      double start, setup, elapsed = 0, rate;
+      size_t evaluations = 0;
+      double **x;
+      FILE *scratch;
+
+      start = launcher_clock();
+      my_problem_localize(&local, problem, arena);
+      my_problem_prepare(&local);
+      if ((scratch = fopen(PLAN_SCRATCH_PATH, "w")) == NULL) {
+        fprintf(stderr, "Cannot write %s.\n", PLAN_SCRATCH_PATH);
+        exit(EXIT_FAILURE);
       }
-      else if(APPROACH == 1){//U-Lm
-        for(int j = 1; j <= (int)upper_bounds[i] + 1; j++){
-          if(x[i] < y[j]){
-            x[i] = y[j - 1] + 1/((upper_bounds[i] + 1)*2);
-            break;
-          }
-        }
+      write_result_file(scratch, &local);
+      fclose(scratch);
+      setup = launcher_clock() - start;
+      launcher->overhead += setup;
+      number_of_settings++;
+      if (timed) {
+        my_problem_release(&local);
+        continue;
       }
-      else if(APPROACH == 2){//U-Lb
-        for(int j = 1; j <= (int)upper_bounds[i] + 1; j++){
-          if(x[i] < y[j]){
-            if(fabs(x[i] - y[j]) < fabs(x[i] - y[j - 1])){
-              x[i] = y[j] - FLT_EPSILON;
-            }
-            else{
-              x[i] = y[j - 1];
-            }
-            break;
+      random_generator = coco_random_new(RANDOM_SEED);
+      start = launcher_clock();
+      while (elapsed < PLAN_CALIBRATION_SECONDS) {
+        if (run == NULL) {
+          /* a run that hit the final target would end at once again */
+          local.evaluation_cnt = 0;
+          local.end_flag = 0;
+          for (size_t j = 0; j < NUMBER_OF_TARGET; j++) {
+            local.evaluate_result[j] = -1;
+            local.first_hit[j] = -1;
           }
+          run = de_run_new(&local, budget, variant, random_generator);
+        }
+        if ((x = de_run_ask(run)) == NULL) {
+          de_run_free(run);
+          run = NULL;
+          continue;
         }
+        de_run_evaluate(run, x);
+        de_run_tell(run);
+        evaluations += variant->population_size;
+        elapsed = launcher_clock() - start;
       }
+      if (run != NULL) {
+        de_run_free(run);
+      }
+      coco_random_free(random_generator);
+      my_problem_release(&local);
+      rate = (double)evaluations / elapsed;
+      cost_model_add(model, problem->function_name, variant, problem->dimension, cost_seed(problem), setup + (double)budget / rate);
+      printf("plan: %s %s r%lu %lud %.3g evaluations/s\n", problem->function_name, variant->name,
+             (unsigned long)problem->r, (unsigned long)problem->dimension, rate);
     }
   }
+  if (number_of_settings > 0) {
+    launcher->overhead /= (double)number_of_settings;
+  }
+  printf("plan: %.3g ms of setup and output per work item\n", 1e3 * launcher->overhead);
+  remove(PLAN_SCRATCH_PATH);
+  coco_free_memory(arena);
 }
 
-void decoding_vec(double *x, size_t dimention_size, const double *lower_bounds, const double *upper_bounds){
-  for(int i = 0; i < dimention_size; i++){
-    if(lower_bounds[i] != -5){
-      x[i] = floor(x[i]*(upper_bounds[i] + 1));
-      if(x[i] > upper_bounds[i]){
-        x[i] = upper_bounds[i];
+/**
+ * Assigns the first number_of_items costs, from the longest to the shortest, to the least loaded
+ * worker in turn and writes them to the order of the launcher. Returns the makespan of this greedy
+ * schedule.
+ */
+static double launcher_balance(launcher_t *launcher, const cost_order_t *costs, size_t number_of_items, size_t number_of_workers, double *load) {
+  double makespan = 0;
+
+  for (size_t w = 0; w < number_of_workers; w++) {
+    load[w] = 0;
+  }
+  for (size_t k = 0; k < number_of_items; k++) {
+    size_t least = 0;
+    for (size_t w = 1; w < number_of_workers; w++) {
+      if (load[w] < load[least]) {
+        least = w;
       }
     }
-    else{
-      x[i] =  10.0 * x[i] - 5.0;
+    load[least] += costs[k].cost;
+    launcher->order[k] = costs[k].item;
+  }
+  for (size_t w = 0; w < number_of_workers; w++) {
+    if (load[w] > makespan) {
+      makespan = load[w];
     }
   }
+  launcher->number_of_items = number_of_items;
+  return makespan;
 }
 
-void ea_sd_calc(double* sum, double* sum2, double** tmp, size_t dimension, FILE *fp){
-  for (int j = 0; j < dimension; j++) {
-    sum[j] = 0;
-    sum2[j] = 0;
+/**
+ * Fits the schedule into the time left before campaign_stop_time. Past the overhead of the
+ * launcher, the costs are proportional to the budget, so budget_multiplier is lowered in
+ * proportion, then further until the balanced schedule fits. With --fit=instances, only the first
+ * instances of every setting are kept instead, as many as fit. Returns the new makespan.
+ */
+static double launcher_fit_deadline(launcher_t *launcher, cost_order_t *costs, size_t number_of_workers, double *load, double makespan) {
+  const double available = campaign_stop_time - launcher_clock();
+  size_t number_of_items = launcher->number_of_items;
+  size_t number_of_instances = 0;
+
+  if (makespan <= available) {
+    printf("deadline: the campaign fits, %.1f s of %.1f s\n", makespan, available);
+    return makespan;
   }
-  //heikin
-  for(int i = 0; i < DE_N; i++){
-    for(int j = 0; j < dimension; j++){
-        sum[j] += tmp[i][j];
+  if (!deadline_fit_instances) {
+    const double overhead = launcher->overhead * ceil((double)number_of_items / (double)number_of_workers);
+    unsigned int fitted = available > overhead ? (unsigned int)floor(budget_multiplier * (available - overhead) / (makespan - overhead)) : 0;
+    cost_order_t *scaled = (cost_order_t *)coco_allocate_memory(number_of_items * sizeof(cost_order_t));
+    double scale;
+
+    while (1) {
+      if (fitted == 0) {
+        fprintf(stderr, "The deadline leaves no budget (%.1f s for %.1f s).\n", available, makespan);
+        exit(EXIT_FAILURE);
+      }
+      scale = (double)fitted / budget_multiplier;
+      for (size_t k = 0; k < number_of_items; k++) {
+        scaled[k].item = costs[k].item;
+        scaled[k].cost = launcher->overhead + scale * fmax(costs[k].cost - launcher->overhead, 0);
+      }
+      if ((makespan = launcher_balance(launcher, scaled, number_of_items, number_of_workers, load)) <= available) {
+        break;
+      }
+      fitted = fitted * 19 / 20;
     }
+    printf("deadline: budget multiplier %u -> %u to fit %.1f s\n", budget_multiplier, fitted, available);
+    budget_multiplier = fitted;
+    for (size_t k = 0; k < number_of_items; k++) {
+      costs[k] = scaled[k];
+      launcher->expected[costs[k].item] = costs[k].cost;
+    }
+    coco_free_memory(scaled);
+    return makespan;
   }
-  for(int j = 0; j < dimension; j++){
-    sum[j] = sum[j]/DE_N;
-  }
-  //bunsan
-  for(int j = 0; j < dimension; j++){
-    for(int i = 0; i < DE_N; i++){
-      sum2[j] += (tmp[i][j] - sum[j])*(tmp[i][j] - sum[j]);
+  for (size_t i = 0; i < launcher->number_of_problem; i++) {
+    if (launcher->problems[i].instance + 1 > number_of_instances) {
+      number_of_instances = launcher->problems[i].instance + 1;
     }
   }
-  //hyoujyunhensa
-  for(int j = 0; j < dimension; j++){
-    fprintf(fp,"%.30lf ",sqrt(sum2[j]/DE_N));
+  while (number_of_instances > 1 && makespan > available) {
+    size_t kept = 0;
+    number_of_instances--;
+    for (size_t k = 0; k < number_of_items; k++) {
+      if (launcher->problems[costs[k].item / launcher->number_of_variants].instance < number_of_instances) {
+        costs[kept++] = costs[k];
+      }
+    }
+    number_of_items = kept;
+    makespan = launcher_balance(launcher, costs, number_of_items, number_of_workers, load);
   }
-  fprintf(fp,"\n");
+  printf("deadline: instances 0-%lu of every setting, %lu of %lu work items, %s %.1f s\n",
+         (unsigned long)number_of_instances - 1, (unsigned long)number_of_items,
+         (unsigned long)(launcher->number_of_problem * launcher->number_of_variants),
+         makespan <= available ? "to fit" : "still longer than", available);
+  return makespan;
 }
 
-//COCO
 /**
- * Allocates memory for the timing_data_t object and initializes it.
+ * Orders the work items from the longest to the shortest expected one, so the workers that take
+ * them from the shared counter end at about the same time, and prints the makespan this greedy
+ * schedule is expected to reach on the workers against the ideal one (the total over the workers).
+ * With --plan or --deadline the classes without measured times are benchmarked first, so the
+ * makespan is a wall time, and the deadline may lower the budget, up to DEADLINE_FIT_ROUNDS times,
+ * or drop work items.
  */
-static timing_data_t *timing_data_initialize(coco_suite_t *suite) {
-
-	timing_data_t *timing_data = (timing_data_t *) coco_allocate_memory(sizeof(*timing_data));
-	size_t function_idx, dimension_idx, instance_idx, i;
-
-	/* Find out the number of all dimensions */
-	coco_suite_decode_problem_index(suite, coco_suite_get_number_of_problems(suite) - 1, &function_idx,
-			&dimension_idx, &instance_idx);
-	timing_data->number_of_dimensions = dimension_idx + 1;
-	timing_data->current_idx = 0;
-	timing_data->output = (char **) coco_allocate_memory(timing_data->number_of_dimensions * sizeof(char *));
-	for (i = 0; i < timing_data->number_of_dimensions; i++) {
-		timing_data->output[i] = NULL;
-	}
-	timing_data->previous_dimension = 0;
-	timing_data->cumulative_evaluations = 0;
-	time(&timing_data->start_time);
-	time(&timing_data->overall_start_time);
-
-	return timing_data;
+static void launcher_schedule(launcher_t *launcher, size_t number_of_workers) {
+  const size_t number_of_items = launcher->number_of_problem * launcher->number_of_variants;
+  cost_order_t *costs = (cost_order_t *)coco_allocate_memory(number_of_items * sizeof(cost_order_t));
+  double *load = coco_allocate_vector(number_of_workers);
+  double total = 0, makespan;
+  cost_model_t *model = (cost_model_t *)coco_allocate_memory(sizeof(cost_model_t));
+
+  for (size_t round = 1; ; round++) {
+    const unsigned int multiplier = budget_multiplier;
+    cost_model_load(model, timing_path);
+    if (plan_only || deadline_seconds > 0) {
+      plan_benchmark(launcher, model);
+    }
+    for (size_t item = 0; item < number_of_items; item++) {
+      costs[item].cost = cost_model_predict(model, &launcher->problems[item / launcher->number_of_variants],
+                                            launcher->variants[item % launcher->number_of_variants]);
+      costs[item].item = item;
+      launcher->expected[item] = costs[item].cost;
+    }
+    qsort(costs, number_of_items, sizeof(cost_order_t), compare_cost_order);
+    makespan = launcher_balance(launcher, costs, number_of_items, number_of_workers, load);
+    if (deadline_seconds <= 0) {
+      break;
+    }
+    makespan = launcher_fit_deadline(launcher, costs, number_of_workers, load, makespan);
+    /* the evaluation rate depends on the budget, so the lowered one is benchmarked again */
+    if (budget_multiplier == multiplier || round == DEADLINE_FIT_ROUNDS) {
+      break;
+    }
+  }
+  for (size_t k = 0; k < launcher->number_of_items; k++) {
+    total += costs[k].cost;
+  }
+  if (total > 0) {
+    printf("expected makespan %.3g, ideal %.3g (+%.1f%%)%s\n", makespan, total / (double)number_of_workers,
+           100 * (makespan * (double)number_of_workers / total - 1), model->seed > 0 ? " seconds" : " seed units");
+  }
+  if (plan_only) {
+    printf("plan: %lu work items on %lu workers, predicted wall time %.1f s after %.1f s of setup\n",
+           (unsigned long)launcher->number_of_items, (unsigned long)number_of_workers, makespan,
+           launcher_clock() - campaign_start);
+  }
+  coco_free_memory(model);
+  coco_free_memory(load);
+  coco_free_memory(costs);
 }
 
 /**
- * Keeps track of the total number of evaluations and elapsed time. Produces an output string when the
- * current problem is of a different dimension than the previous one or when NULL.
+ * Writes the measured time of every work item done, one line "function variant dimension r range
+ * instance seconds" per item, to be read back by cost_model_load on the next run.
  */
-static void timing_data_time_problem(timing_data_t *timing_data, coco_problem_t *problem) {
+static void write_timing_report(const launcher_t *launcher, const char *path) {
+  char tmp_path[1024];
+  FILE *fp;
 
-	double elapsed_seconds = 0;
+  if (snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(tmp_path)) {
+    fprintf(stderr, "Timing path %s is too long.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  fp = fopen(tmp_path, "w");
+  if (fp == NULL) {
+    fprintf(stderr, "Cannot write timing report %s: %s\n", tmp_path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  fprintf(fp, "# function variant dimension r range instance seconds\n");
+  for (size_t item = 0; item < launcher->number_of_problem * launcher->number_of_variants; item++) {
+    const MY_PROBLEM *problem = &launcher->problems[item / launcher->number_of_variants];
+    if (launcher->seconds[item] < 0) {
+      continue;
+    }
+    fprintf(fp, "%s %s %lu %lu %d %lu %.6f\n", problem->function_name, launcher->variants[item % launcher->number_of_variants]->name,
+            (unsigned long)problem->dimension, (unsigned long)problem->r, my_problem_range(problem),
+            (unsigned long)problem->instance, launcher->seconds[item]);
+  }
+  if (ferror(fp) || fclose(fp) != 0 || rename(tmp_path, path) != 0) {
+    fprintf(stderr, "Cannot write timing report %s: %s\n", path, strerror(errno));
+    remove(tmp_path);
+    exit(EXIT_FAILURE);
+  }
+}
 
-	if ((problem == NULL) || (timing_data->previous_dimension != coco_problem_get_dimension(problem))) {
+/**
+ * Returns 1 if the dimension is one of the comma-separated list of --dimensions, or if there is none.
+ */
+static int slice_has_dimension(size_t dimension) {
+  const char *p = slice_dimensions;
+  char *end;
 
-		/* Output existing timing information */
-		if (timing_data->cumulative_evaluations > 0) {
-			time_t now;
-			time(&now);
-			elapsed_seconds = difftime(now, timing_data->start_time) / (double) timing_data->cumulative_evaluations;
-			timing_data->output[timing_data->current_idx++] = coco_strdupf("d=%lu done in %.2e seconds/evaluation\n",
-					timing_data->previous_dimension, elapsed_seconds);
-		}
+  if (p == NULL) {
+    return 1;
+  }
+  while (*p != '\0') {
+    const unsigned long value = strtoul(p, &end, 10);
+    if (end == p || (*end != ',' && *end != '\0')) {
+      fprintf(stderr, "Bad --dimensions %s.\n", slice_dimensions);
+      exit(EXIT_FAILURE);
+    }
+    if (value == dimension) {
+      return 1;
+    }
+    p = *end == ',' ? end + 1 : end;
+  }
+  return 0;
+}
 
-		if (problem != NULL) {
-			/* Re-initialize the timing_data */
-			timing_data->previous_dimension = coco_problem_get_dimension(problem);
-			timing_data->cumulative_evaluations = coco_problem_get_evaluations(problem);
-			time(&timing_data->start_time);
-		}
+/**
+ * Keeps the problems of the dimensions of --dimensions and the first --instances instances of
+ * every setting, in their order, and frees the other ones. The random stream of a problem follows
+ * its index among the kept ones.
+ */
+static void launcher_slice(launcher_t *launcher) {
+  size_t kept = 0;
 
-	} else {
-		timing_data->cumulative_evaluations += coco_problem_get_evaluations(problem);
-	}
+  for (size_t i = 0; i < launcher->number_of_problem; i++) {
+    MY_PROBLEM *problem = &launcher->problems[i];
+    if ((slice_instances <= 0 || problem->instance < (size_t)slice_instances) && slice_has_dimension(problem->dimension)) {
+      launcher->problems[kept++] = *problem;
+    }
+    else {
+      free_problem(problem);
+    }
+  }
+  if (kept == 0) {
+    fprintf(stderr, "No problem is left by --dimensions and --instances.\n");
+    exit(EXIT_FAILURE);
+  }
+  launcher->number_of_problem = kept;
 }
 
 /**
- * Outputs and finalizes the given timing data.
+ * Records the outcome of a work item done on its problem for the results table of --sweep.
  */
-static void timing_data_finalize(timing_data_t *timing_data) {
+static void launcher_record(launcher_t *launcher, size_t item, const MY_PROBLEM *problem) {
+  launcher_result_t *result = &launcher->results[item];
 
-	/* Record the last problem */
-	timing_data_time_problem(timing_data, NULL);
+  result->targets = 0;
+  for (size_t k = 0; k < NUMBER_OF_TARGET; k++) {
+    result->targets += problem->first_hit[k] != -1;
+  }
+  result->solved = problem->first_hit[NUMBER_OF_TARGET - 1] != -1;
+  result->evaluations = result->solved ? problem->first_hit[NUMBER_OF_TARGET - 1] : (double)problem->evaluation_cnt;
+}
 
-  if (timing_data) {
-  	size_t i;
-  	double elapsed_seconds;
-		time_t now;
-		int hours, minutes, seconds;
+/* A line of the results table of --sweep. */
+typedef struct sweep_row{
+  const char *function_name;
+  size_t dimension;
+  size_t problems;
+  size_t targets;
+  size_t solved;
+  double evaluations;
+}sweep_row_t;
 
-		time(&now);
-		elapsed_seconds = difftime(now, timing_data->overall_start_time);
+/**
+ * Writes the results table of --sweep: for every configuration, function and dimension, the
+ * problems done, the fraction of the targets they hit, the ones that hit the final target and the
+ * expected running time to it (the evaluations of all problems over the solved ones, inf if none).
+ */
+static void write_sweep_table(const launcher_t *launcher, const char *path) {
+  sweep_row_t *rows = (sweep_row_t *)coco_allocate_memory(launcher->number_of_problem * sizeof(sweep_row_t));
+  FILE *fp = fopen(path, "w");
 
-  	printf("\n");
-  	for (i = 0; i < timing_data->number_of_dimensions; i++) {
-    	if (timing_data->output[i]) {
-				printf("%s", timing_data->output[i]);
-				coco_free_memory(timing_data->output[i]);
-    	}
+  if (fp == NULL) {
+    fprintf(stderr, "Cannot write sweep table %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  fprintf(fp, "# config variant N CR F function dimension problems targets solved ert\n");
+  for (size_t v = 0; v < launcher->number_of_variants; v++) {
+    const de_variant_t *variant = launcher->variants[v];
+    size_t number_of_rows = 0;
+    for (size_t i = 0; i < launcher->number_of_problem; i++) {
+      const MY_PROBLEM *problem = &launcher->problems[i];
+      const size_t item = i * launcher->number_of_variants + v;
+      const launcher_result_t *result = &launcher->results[item];
+      size_t r = 0;
+      if (launcher->seconds[item] < 0) {
+        continue;
+      }
+      while (r < number_of_rows && (rows[r].dimension != problem->dimension || strcmp(rows[r].function_name, problem->function_name) != 0)) {
+        r++;
+      }
+      if (r == number_of_rows) {
+        memset(&rows[r], 0, sizeof(rows[r]));
+        rows[r].function_name = problem->function_name;
+        rows[r].dimension = problem->dimension;
+        number_of_rows++;
+      }
+      rows[r].problems++;
+      rows[r].targets += result->targets;
+      rows[r].solved += (size_t)result->solved;
+      rows[r].evaluations += result->evaluations;
     }
-  	hours = (int) elapsed_seconds / 3600;
-  	minutes = ((int) elapsed_seconds % 3600) / 60;
-  	seconds = (int)elapsed_seconds - (hours * 3600) - (minutes * 60);
-  	printf("Total elapsed time: %dh%02dm%02ds\n", hours, minutes, seconds);
-
-    coco_free_memory(timing_data->output);
-    coco_free_memory(timing_data);
+    for (size_t r = 0; r < number_of_rows; r++) {
+      fprintf(fp, "%s %s %lu %g %g %s %lu %lu %.4f %lu %.6g\n", variant->name,
+              find_de_variant_by_code(variant->encoding, variant->approach)->name,
+              (unsigned long)variant->population_size, variant->cr, variant->f, rows[r].function_name,
+              (unsigned long)rows[r].dimension, (unsigned long)rows[r].problems,
+              (double)rows[r].targets / (double)(rows[r].problems * NUMBER_OF_TARGET), (unsigned long)rows[r].solved,
+              rows[r].solved > 0 ? rows[r].evaluations / (double)rows[r].solved : INFINITY);
+    }
+  }
+  if (ferror(fp) || fclose(fp) != 0) {
+    fprintf(stderr, "Cannot write sweep table %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
   }
+  coco_free_memory(rows);
+  printf("sweep: %lu configurations, results table %s\n", (unsigned long)launcher->number_of_variants, path);
 }
 
-// the function is able to get coco-function number
-char *get_short_function_number(const char *problem_name) {
-    const char *f_position = strstr(problem_name, "f");
-    if (f_position == NULL) {
-        return NULL;  // "f"が見つからない場合はNULLを返す
-    }
-
-    int number = atoi(f_position + 1); // "f"の後ろから整数部分を取得
-    char *short_name = (char *)malloc(10 * sizeof(char));
-    if (short_name == NULL) {
-        return NULL;  // メモリ割り当てに失敗した場合はNULLを返す
-    }
+static double launcher_clock(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + 1e-9 * (double)now.tv_nsec;
+}
 
-    sprintf(short_name, "f%d", number); // 短縮形式の"f1"や"f2"を生成
-    return short_name;
+/**
+ * Returns 1 once the campaign has to stop: campaign_stop_time (--deadline) has passed, or the
+ * launcher received SIGTERM or SIGUSR1.
+ */
+int campaign_stopping(void) {
+  return campaign_stop_signal || (campaign_stop_time > 0 && launcher_clock() >= campaign_stop_time);
 }
 
-//EA algorithm
-void de_nopcm(evaluate_function_t evaluate_func,
-                      const size_t dimension,
-                      const size_t number_of_objectives,
-                      const double *lower_bounds,
-                      const double *upper_bounds,
-                      const size_t max_budget,
-                      coco_random_state_t *random_generator,
-                      char *titlestr){
-  double **population = (double**)malloc(DE_N * sizeof(double*));
-  double *functions_values = coco_allocate_vector(number_of_objectives);
-  double **trial = (double**)malloc(DE_N * sizeof(double*));
-  double *mutate = coco_allocate_vector(dimension);
-  double **tmp = (double**)malloc(DE_N * sizeof(double*));
-  double *rnd_vals = coco_allocate_vector(dimension);
-  size_t evaluation = 0;
-  size_t i, j;
-  int vector[3];
-  double value_population[DE_N];
-  double value_trial[DE_N];
-  //FILE *fp;
-  double *sum = coco_allocate_vector(dimension); 
-  double *sum2 = coco_allocate_vector(dimension); 
-  int output_cnt = 0;
-  //fp = fopen(titlestr, "w");
+static void campaign_signal(int signal_number) {
+  (void)signal_number;
+  campaign_stop_signal = 1;
+}
 
-  for (i = 0; i < DE_N; i++) {
-        population[i] = coco_allocate_vector(dimension);
-        trial[i] = coco_allocate_vector(dimension);
-        tmp[i] = coco_allocate_vector(dimension);
-        if (population[i] == NULL) {
-            printf("メモリの確保に失敗しました。\n");
-        }
+/**
+ * Parses a duration "[[hh:]mm:]ss" into seconds, like the walltime of a PBS job.
+ */
+double parse_duration(const char *text) {
+  double seconds = 0;
+  const char *field = text;
+
+  while (1) {
+    char *end;
+    double value = strtod(field, &end);
+    if (end == field || value < 0) {
+      break;
+    }
+    seconds = 60 * seconds + value;
+    if (*end == '\0') {
+      return seconds;
+    }
+    if (*end != ':') {
+      break;
+    }
+    field = end + 1;
   }
-  //initialization
-  ea_group_initialization(population, dimension, lower_bounds, upper_bounds, random_generator);
-  //encoding
-  ea_group_encoding(population, tmp, dimension, lower_bounds, upper_bounds);
-  //evaluation
-  for (i = 0; i < DE_N; i++) {
-    evaluate_func(tmp[i], functions_values);
-    evaluation++;
-    value_population[i] = functions_values[0];
+  fprintf(stderr, "Invalid duration %s, expected [[hh:]mm:]ss.\n", text);
+  exit(EXIT_FAILURE);
+}
+
+/**
+ * Runs the jobs of several problems on the calling worker, interleaved: every round asks all runs
+ * for their points, evaluates them and tells all runs. With COLUMN_EVALUATION, the points of the
+ * batchable runs whose problems share the function, dimension and number of integer variables are
+ * evaluated in one batch (my_evaluate_problems), the other ones on their own. The DE steps of a
+ * run do not depend on the other runs, so every problem gets the same results as when it is run
+ * alone.
+ */
+static void launcher_run_jobs(my_problem_job_t *jobs, size_t number_of_jobs) {
+  size_t capacity = 0;
+  const MY_PROBLEM **problems;
+  double **points;
+  double *values;
+  double ***asked = (double ***)coco_allocate_memory(number_of_jobs * sizeof(*asked));
+  int *active = (int *)coco_allocate_memory(number_of_jobs * sizeof(int));
+  int *pending = (int *)coco_allocate_memory(number_of_jobs * sizeof(int));
+  size_t *members = (size_t *)coco_allocate_memory(number_of_jobs * sizeof(size_t));
+  size_t max_dimension = 0, number_of_active = number_of_jobs;
+  double *columns;
+
+  for (size_t b = 0; b < number_of_jobs; b++) {
+    capacity += jobs[b].variant->population_size;
   }
-  //hanpuku
-  while(evaluation  < max_budget){
-    //hyoujyunhensa+output
-    if(output_cnt == 0){
-      //ea_sd_calc(sum, sum2, tmp, dimension, fp);
+  problems = (const MY_PROBLEM **)coco_allocate_memory(capacity * sizeof(*problems));
+  points = (double **)coco_allocate_memory(capacity * sizeof(*points));
+  values = coco_allocate_vector(capacity);
+  for (size_t b = 0; b < number_of_jobs; b++) {
+    active[b] = 1;
+    if (jobs[b].problem->dimension > max_dimension) {
+      max_dimension = jobs[b].problem->dimension;
     }
-    output_cnt++;
-    if(output_cnt == dimension){
-      output_cnt = 0;
+  }
+  columns = coco_allocate_vector((max_dimension + 2) * COLUMN_TILE);
+  while (number_of_active > 0) {
+    number_of_active = 0;
+    for (size_t b = 0; b < number_of_jobs; b++) {
+      asked[b] = active[b] ? my_problem_job_ask(&jobs[b]) : NULL;
+      if (active[b] && asked[b] == NULL) {
+        my_problem_job_end(&jobs[b]);
+        active[b] = 0;
+      }
+      pending[b] = COLUMN_EVALUATION && asked[b] != NULL && jobs[b].run->delta == NULL && my_problem_batchable(jobs[b].problem);
+      if (asked[b] != NULL && !pending[b]) {
+        de_run_evaluate(jobs[b].run, asked[b]);
+      }
+      number_of_active += (size_t)active[b];
     }
-
-    for (i = 0; i < DE_N; i++) {
-      //selection
-      vector[0] = (int)(coco_random_uniform(random_generator)*DE_N);
-      do {
-          vector[1] = (int)(coco_random_uniform(random_generator)*DE_N);
-      } while (vector[1] == vector[0]);
-
-      do {
-          vector[2] = (int)(coco_random_uniform(random_generator)*DE_N);
-      } while (vector[2] == vector[0] || vector[2] == vector[1]);
-      //mutation
-      for (j = 0; j < dimension; j++) {
-        mutate[j] = population[vector[0]][j] + DE_F * (population[vector[1]][j] - population[vector[2]][j]);
-        if(ENCODING== 0){
-          if (mutate[j] < lower_bounds[j]){
-            mutate[j] = (lower_bounds[j] + population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > upper_bounds[j]){
-            mutate[j] = (upper_bounds[j] + population[i][j]) / 2.0;
-          }
-        }
-        else if(ENCODING == 1){
-          if (mutate[j] < 0){
-            mutate[j] = (population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > 1){
-            mutate[j] = (1 + population[i][j]) / 2.0;
-          }
-        }
-        else if(ENCODING == 2){
-          if (mutate[j] < lower_bounds[j] - 0.5){
-            mutate[j] = (lower_bounds[j] - 0.5 + population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > upper_bounds[j] + 0.5 - FLT_EPSILON){
-            mutate[j] = (upper_bounds[j] + 0.5 - FLT_EPSILON + population[i][j]) / 2.0;
+    for (size_t b = 0; b < number_of_jobs; b++) {
+      const MY_PROBLEM *first = jobs[b].problem;
+      size_t number_of_members = 0, number_of_points = 0;
+      if (!pending[b]) {
+        continue;
+      }
+      for (size_t c = b; c < number_of_jobs; c++) {
+        const MY_PROBLEM *problem = jobs[c].problem;
+        if (pending[c] && problem->function == first->function && problem->dimension == first->dimension
+            && problem->number_of_integer_variables == first->number_of_integer_variables) {
+          members[number_of_members++] = c;
+          pending[c] = 0;
+          for (size_t i = 0; i < jobs[c].variant->population_size; i++) {
+            problems[number_of_points] = problem;
+            points[number_of_points++] = asked[c][i];
           }
         }
       }
-      //crossover
-      int j_rand = (int)(coco_random_uniform(random_generator)*(int)dimension);
-
-      // Generate random values between 0 and 1
-      for (j = 0; j < dimension; j++) {
-          rnd_vals[j] = coco_random_uniform(random_generator);
-      }
-      // Set rnd_vals[j_rand] to 0.0
-      rnd_vals[j_rand] = 0.0;
-      // Perform binomial crossover
-      for (j = 0; j < dimension; j++) {
-          if (rnd_vals[j] <= DE_CR) {
-              trial[i][j] = mutate[j];
-          } else {
-              trial[i][j] = population[i][j];
-          }
+      my_evaluate_problems(problems, points, number_of_points, values, columns);
+      number_of_points = 0;
+      for (size_t m = 0; m < number_of_members; m++) {
+        const size_t population_size = jobs[members[m]].variant->population_size;
+        memcpy(jobs[members[m]].run->values, values + number_of_points, population_size * sizeof(double));
+        number_of_points += population_size;
       }
     }
-    //encoding
-    ea_group_encoding(trial, tmp, dimension, lower_bounds, upper_bounds);
-    //evaluation
-    for (i = 0; i < DE_N; i++) {
-      evaluate_func(tmp[i], functions_values);
-      evaluation++;
-      value_trial[i] = functions_values[0];
-    }
-
-    //enviroment selection
-    for(i = 0; i < DE_N; i++){
-      if(value_trial[i] <= value_population[i]){
-        for (j = 0; j < dimension; j++) {
-          population[i][j] = trial[i][j];
-        }
-        value_population[i] = value_trial[i];
+    for (size_t b = 0; b < number_of_jobs; b++) {
+      if (asked[b] != NULL) {
+        de_run_tell(jobs[b].run);
       }
     }
   }
-  //next instance
-  instance_cnt++;
-  if(instance_cnt == 15){
-    instance_cnt = 0;
-  }
-  //fclose(fp);
-  //memory free
-  for (i = 0; i < DE_N; ++i) {
-    coco_free_memory(population[i]);
-    coco_free_memory(trial[i]);
-    coco_free_memory(tmp[i]);
-  }
-  free(population);
-  coco_free_memory(functions_values);
-  coco_free_memory(mutate);
-  coco_free_memory(tmp);
-  coco_free_memory(rnd_vals);
-  coco_free_memory(sum);
-  coco_free_memory(sum2);
+  coco_free_memory(columns);
+  coco_free_memory(members);
+  coco_free_memory(pending);
+  coco_free_memory(active);
+  coco_free_memory(asked);
+  coco_free_memory(values);
+  coco_free_memory(points);
+  coco_free_memory(problems);
 }
 
-int find_min_index(double value_population[]) {
-  int min_index = 0;  // 最初の要素を最小値と仮定
-  for (int i = 1; i < DE_N; i++) {
-      if (value_population[i] < value_population[min_index]) {
-          min_index = i;  // 最小値を更新
-      }
+/**
+ * Runs a group of work items interleaved (see launcher_run_jobs), each problem copied into its
+ * part of the arena (4 * INTERLEAVE_MAX_DIMENSION doubles each) and with its own generator, and
+ * splits the time of the group over its items in proportion to their seeds (-1 for the items
+ * aborted when the campaign stopped).
+ */
+static void launcher_run_group(launcher_t *launcher, const size_t *items, size_t number_of_items, double *arena) {
+  my_problem_job_t jobs[INTERLEAVE_WIDTH];
+  MY_PROBLEM locals[INTERLEAVE_WIDTH];
+  const double start = launcher_clock();
+  double seed = 0, seconds;
+
+  ALLOC_PHASE(ALLOC_PHASE_SETUP);
+  for (size_t k = 0; k < number_of_items; k++) {
+    const size_t problem_index = items[k] / launcher->number_of_variants;
+    my_problem_localize(&locals[k], &launcher->problems[problem_index], arena + k * 4 * INTERLEAVE_MAX_DIMENSION);
+    my_problem_job_begin(&jobs[k], &locals[k], launcher->variants[items[k] % launcher->number_of_variants],
+                         coco_random_new(RANDOM_SEED + (uint32_t)(problem_index + 1)), launcher->runtime_file);
+    seed += cost_seed(&locals[k]);
+  }
+  launcher_run_jobs(jobs, number_of_items);
+  seconds = launcher_clock() - start;
+  for (size_t k = 0; k < number_of_items; k++) {
+    coco_random_free(jobs[k].random_generator);
+    launcher->seconds[items[k]] = jobs[k].aborted ? -1 : seconds * cost_seed(&locals[k]) / seed;
+    if (launcher->results != NULL && !jobs[k].aborted) {
+      launcher_record(launcher, items[k], &locals[k]);
+    }
   }
-  return min_index;
 }
 
-void my_de_nopcm(const char* function_name,
-                      const size_t dimension,
-                      const size_t number_of_objectives,
-                      const double *lower_bounds,
-                      const double *upper_bounds,
-                      const size_t max_budget,
-                      coco_random_state_t *random_generator,
-                      char *titlestr,
-                      MY_PROBLEM *problem){
-  double **population = (double**)malloc(DE_N * sizeof(double*));
-  double *functions_values = coco_allocate_vector(number_of_objectives);
-  double *tmp_functions_values = coco_allocate_vector(number_of_objectives);
-  double **trial = (double**)malloc(DE_N * sizeof(double*));
-  double *mutate = coco_allocate_vector(dimension);
-  double **tmp = (double**)malloc(DE_N * sizeof(double*));
-  double *rnd_vals = coco_allocate_vector(dimension);
-  int evaluation = 0;
-  size_t i, j;
-  int vector[3];
-  int min_pos = 0;
-  double value_population[DE_N];
-  double value_trial[DE_N];
-  //FILE *fp;
-  double *sum = coco_allocate_vector(dimension); 
-  double *sum2 = coco_allocate_vector(dimension); 
-  int output_cnt = 0;
-  //fp = fopen(titlestr, "w");
-  for (i = 0; i < DE_N; i++) {
-        population[i] = coco_allocate_vector(dimension);
-        trial[i] = coco_allocate_vector(dimension);
-        tmp[i] = coco_allocate_vector(dimension);
-        if (population[i] == NULL) {
-            printf("メモリの確保に失敗しました。\n");
-        }
+/**
+ * Runs the pending group of a worker (see launcher_run_group). With a deadline, the group runs
+ * without its last items if it is not expected to end before the deadline otherwise: the group
+ * takes about the sum of the expected times of its items.
+ */
+static void launcher_flush_group(launcher_t *launcher, const size_t *group, size_t group_size, double *arena) {
+  if (campaign_stop_time > 0) {
+    const double now = launcher_clock();
+    double expected = 0;
+    size_t fitting = 0;
+
+    while (fitting < group_size && now + expected + launcher->expected[group[fitting]] <= campaign_stop_time) {
+      expected += launcher->expected[group[fitting++]];
+    }
+    group_size = fitting;
   }
-  //initialization
-  ea_group_initialization(population, dimension, lower_bounds, upper_bounds, random_generator);
-  
-  // for(i = 0; i < DE_N; i++){
-  //   for(j = 0; j < dimension; j++){
-  //     printf("%.30lf ", population[i][j]);
-  //   }
-  //   printf("\n");
-  // }
-  
-  //encoding
-  ea_group_encoding(population, tmp, dimension, lower_bounds, upper_bounds);
-  //evaluation
-  for (i = 0; i < DE_N; i++) {
-    my_evaluate_func(tmp[i], functions_values, function_name, dimension, problem->optimal);
-    evaluation++;
-    value_population[i] = functions_values[0];
+  if (group_size > 0) {
+    launcher_run_group(launcher, group, group_size, arena);
   }
-  min_pos =  find_min_index(value_population);
-  for(size_t target_cnt = 0; target_cnt < NUMBER_OF_TARGET; target_cnt++){
-    if(target[target_cnt] > value_population[min_pos]){
-      if(problem->evaluate_result[target_cnt] == -1){
-        problem->evaluate_result[target_cnt] = evaluation;
-      }
-      else if(problem->evaluate_result[target_cnt] > evaluation){
-        problem->evaluate_result[target_cnt] = evaluation;
-      }
-      if(target_cnt == NUMBER_OF_TARGET - 1){
-        problem->end_flag = 1;
-      }
+}
+
+/**
+ * Worker of the launcher: pins itself, then takes work items until none are left. Everything the
+ * worker writes during a run (arena, DE population, integer table) is allocated after pinning and
+ * first touched by the worker, so it is placed on the worker's node. Every problem gets its own
+ * generator seeded from its index, so the results do not depend on the scheduling and all variants
+ * see the same random stream on a problem. Problems of at most INTERLEAVE_MAX_DIMENSION are
+ * gathered into groups of INTERLEAVE_WIDTH and run interleaved (see launcher_run_jobs), unless
+ * trajectories are logged, which takes one problem at a time per worker. Once the campaign stops,
+ * or with a deadline if an item is not expected to end before it, the items are not started. The
+ * items of a group all end about when the group does, after the sum of their expected times, so
+ * an item that would make its pending group end after the deadline runs the group without it
+ * first (see launcher_flush_group).
+ */
+static void *launcher_worker_run(void *arg) {
+  launcher_worker_t *worker = (launcher_worker_t *)arg;
+  launcher_t *launcher = worker->launcher;
+  const size_t number_of_items = launcher->number_of_items;
+  const int interleave = INTERLEAVE_WIDTH > 1 && trajectory_logger == NULL;
+  double *arena, *group_arena;
+  size_t group[INTERLEAVE_WIDTH];
+  size_t group_size = 0;
+  double group_expected = 0; //sum of the expected times of the items of the group
+  size_t position;
+
+  if (worker->cpu >= 0) {
+    cpu_set_t cpu;
+    CPU_ZERO(&cpu);
+    CPU_SET((size_t)worker->cpu, &cpu);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu) != 0) {
+      fprintf(stderr, "Cannot pin a worker to CPU %d.\n", worker->cpu);
     }
   }
-  //hanpuku
-  while(evaluation  < max_budget){
-    if(problem->end_flag == 1){
-      break;
+  arena = coco_allocate_vector(4 * launcher->max_dimension);
+  memset(arena, 0, 4 * launcher->max_dimension * sizeof(double));
+  group_arena = coco_allocate_vector(4 * INTERLEAVE_WIDTH * INTERLEAVE_MAX_DIMENSION);
+  memset(group_arena, 0, 4 * INTERLEAVE_WIDTH * INTERLEAVE_MAX_DIMENSION * sizeof(double));
+  while ((position = __atomic_fetch_add(&launcher->next, 1, __ATOMIC_RELAXED)) < number_of_items) {
+    const size_t item = launcher->order[position];
+    const size_t problem_index = item / launcher->number_of_variants;
+    double start;
+    int done;
+    MY_PROBLEM local;
+    coco_random_state_t *random_generator;
+
+    if (campaign_stopping() || (campaign_stop_time > 0 && launcher_clock() + launcher->expected[item] > campaign_stop_time)) {
+      continue;
     }
-
-    //hyoujyunhensa+output
-    if(output_cnt == 0){
-      //ea_sd_calc(sum, sum2, tmp, dimension, fp);
+    if (interleave && launcher->problems[problem_index].dimension <= INTERLEAVE_MAX_DIMENSION) {
+      if (campaign_stop_time > 0 && group_size > 0
+          && launcher_clock() + group_expected + launcher->expected[item] > campaign_stop_time) {
+        /* the group would end after the deadline with the item, so it runs first without it */
+        launcher_flush_group(launcher, group, group_size, group_arena);
+        group_size = 0;
+        group_expected = 0;
+        if (campaign_stopping() || launcher_clock() + launcher->expected[item] > campaign_stop_time) {
+          continue;
+        }
+      }
+      group[group_size++] = item;
+      group_expected += launcher->expected[item];
+      if (group_size == INTERLEAVE_WIDTH) {
+        launcher_flush_group(launcher, group, group_size, group_arena);
+        group_size = 0;
+        group_expected = 0;
+      }
+      continue;
     }
-    output_cnt++;
-    if(output_cnt == dimension){
-      output_cnt = 0;
-    }
-
-    for (i = 0; i < DE_N; i++) {
-      //selection
-      vector[0] = (int)(coco_random_uniform(random_generator)*DE_N);
-      do {
-          vector[1] = (int)(coco_random_uniform(random_generator)*DE_N);
-      } while (vector[1] == vector[0]);
-
-      do {
-          vector[2] = (int)(coco_random_uniform(random_generator)*DE_N);
-      } while (vector[2] == vector[0] || vector[2] == vector[1]);
-      //mutation
-      for (j = 0; j < dimension; j++) {
-        mutate[j] = population[vector[0]][j] + DE_F * (population[vector[1]][j] - population[vector[2]][j]);
-        if(ENCODING== 0){
-          if (mutate[j] < lower_bounds[j]){
-            mutate[j] = (lower_bounds[j] + population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > upper_bounds[j]){
-            mutate[j] = (upper_bounds[j] + population[i][j]) / 2.0;
-          }
-        }
-        else if(ENCODING == 1){
-          if (mutate[j] < 0){
-            mutate[j] = (population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > 1){
-            mutate[j] = (1 + population[i][j]) / 2.0;
-          }
-        }
-        else if(ENCODING == 2){
-          if (mutate[j] < lower_bounds[j] - 0.5){
-            mutate[j] = (lower_bounds[j] - 0.5 + population[i][j]) / 2.0;
-          }
-          else if(mutate[j] > upper_bounds[j] + 0.5 - FLT_EPSILON){
-            mutate[j] = (upper_bounds[j] + 0.5 - FLT_EPSILON + population[i][j]) / 2.0;
-          }
-        }
-      }
-      //crossover
-      int j_rand = (int)(coco_random_uniform(random_generator)*(int)dimension);
-
-      // Generate random values between 0 and 1.
-      for (j = 0; j < dimension; j++) {
-          rnd_vals[j] = coco_random_uniform(random_generator);
-      }
-      // Set rnd_vals[j_rand] to 0.0
-      rnd_vals[j_rand] = 0.0;
-      // Perform binomial crossover
-      for (j = 0; j < dimension; j++) {
-          if (rnd_vals[j] <= DE_CR) {
-              trial[i][j] = mutate[j];
-          } else {
-              trial[i][j] = population[i][j];
-          }
-      }
-    }
-    //encoding
-    ea_group_encoding(trial, tmp, dimension, lower_bounds, upper_bounds);
-    //evaluation
-    for (i = 0; i < DE_N; i++) {
-      my_evaluate_func(tmp[i], functions_values, function_name, dimension, problem->optimal);
-      evaluation++;
-      value_trial[i] = functions_values[0];
+    start = launcher_clock();
+    ALLOC_PHASE(ALLOC_PHASE_SETUP);
+    random_generator = coco_random_new(RANDOM_SEED + (uint32_t)(problem_index + 1));
+    my_problem_localize(&local, &launcher->problems[problem_index], arena);
+    done = run_my_problem(&local, launcher->variants[item % launcher->number_of_variants], random_generator, launcher->runtime_file);
+    coco_random_free(random_generator);
+    launcher->seconds[item] = done ? launcher_clock() - start : -1;
+    if (launcher->results != NULL && done) {
+      launcher_record(launcher, item, &local);
     }
+  }
+  if (group_size > 0) {
+    launcher_flush_group(launcher, group, group_size, group_arena);
+  }
+  coco_free_memory(group_arena);
+  coco_free_memory(arena);
+  return NULL;
+}
 
-    //enviroment selection
-    for(i = 0; i < DE_N; i++){
-      if(value_trial[i] <= value_population[i]){
-        for (j = 0; j < dimension; j++) {
-          population[i][j] = trial[i][j];
-        }
-        value_population[i] = value_trial[i];
-      }
+/**
+ * Runs the variants on the problems of the custom suite with launcher_workers pinned threads
+ * (--workers), spread over the NUMA nodes round-robin, longest expected work item first (see
+ * launcher_schedule). The result files are the same as the ones of my_example_experiment, but the
+ * random streams are per problem. The small problems are run interleaved in groups (see
+ * launcher_worker_run). With --timing the measured times are written to the timing report, which
+ * refines the cost model of the next run. With --plan only the schedule is predicted; with
+ * --deadline, SIGTERM or SIGUSR1 the campaign stops early, and the problems done keep their
+ * results (see campaign_stopping). --dimensions and --instances run a slice of the problems, and
+ * with --sweep the variants are the sweep configurations, whose results table is written at the end.
+ *
+ * @param variants The DE variants, run on every problem.
+ * @param number_of_variants The number of variants.
+ * @param random_generator The random number generator of the problem generation.
+ */
+void my_example_launcher(const de_variant_t *const *variants,
+                         size_t number_of_variants,
+                         coco_random_state_t *random_generator) {
+  numa_topology_t topology = numa_topology_discover();
+  launcher_worker_t workers[MAX_WORKERS];
+  size_t number_of_workers = launcher_workers > 0 ? (size_t)launcher_workers : topology.number_of_cpus;
+  launcher_t launcher;
+  struct sigaction stop;
+  double start, total = 0;
+  size_t done = 0;
+
+  if (number_of_workers > MAX_WORKERS) {
+    fprintf(stderr, "Too many workers (at most %d).\n", MAX_WORKERS);
+    exit(EXIT_FAILURE);
+  }
+  launcher.problems = load_problems(random_generator, &launcher.number_of_problem);
+  launcher_slice(&launcher);
+  launcher.variants = variants;
+  launcher.number_of_variants = number_of_variants;
+  launcher.max_dimension = 0;
+  for (size_t i = 0; i < launcher.number_of_problem; i++) {
+    if (launcher.problems[i].dimension > launcher.max_dimension) {
+      launcher.max_dimension = launcher.problems[i].dimension;
     }
-
-    min_pos =  find_min_index(value_population);
-    for(size_t target_cnt = 0; target_cnt < NUMBER_OF_TARGET; target_cnt++){
-      if(target[target_cnt] > value_population[min_pos]){
-        if(problem->evaluate_result[target_cnt] == -1){
-          problem->evaluate_result[target_cnt] = evaluation;
-        }
-        else{
-          if(problem->evaluate_result[target_cnt] > evaluation){
-            problem->evaluate_result[target_cnt] = evaluation;
-          }
-        }
-        if(target_cnt == NUMBER_OF_TARGET - 1){
-          problem->end_flag = 1;
-        }
-      }
+  }
+  launcher.order = (size_t *)coco_allocate_memory(launcher.number_of_problem * number_of_variants * sizeof(size_t));
+  launcher.expected = coco_allocate_vector(launcher.number_of_problem * number_of_variants);
+  launcher.overhead = 0;
+  launcher.seconds = coco_allocate_vector(launcher.number_of_problem * number_of_variants);
+  for (size_t item = 0; item < launcher.number_of_problem * number_of_variants; item++) {
+    launcher.seconds[item] = -1;
+  }
+  launcher.results = NULL;
+  if (number_of_sweep_variants > 0) {
+    launcher.results = (launcher_result_t *)coco_allocate_memory(launcher.number_of_problem * number_of_variants * sizeof(launcher_result_t));
+  }
+  launcher.next = 0;
+  printf("%lu workers on %lu CPUs of %lu NUMA nodes\n", (unsigned long)number_of_workers,
+         (unsigned long)topology.number_of_cpus, (unsigned long)topology.number_of_nodes);
+  launcher_schedule(&launcher, number_of_workers);
+  fflush(stdout);
+  if (plan_only) {
+    number_of_workers = 0;
+  }
+  /* the budget multiplier of the header is known once the deadline is fitted */
+  launcher.runtime_file = runtime_path != NULL && !plan_only ? open_runtimes(runtime_path) : NULL;
+  memset(&stop, 0, sizeof(stop));
+  stop.sa_handler = campaign_signal;
+  sigemptyset(&stop.sa_mask);
+  sigaction(SIGTERM, &stop, NULL);
+  sigaction(SIGUSR1, &stop, NULL);
+
+  start = launcher_clock();
+
+  for (size_t w = 0; w < number_of_workers; w++) {
+    workers[w].launcher = &launcher;
+    /* more workers than CPUs are not pinned */
+    workers[w].cpu = w < topology.number_of_cpus ? topology.cpus[w] : -1;
+    if (pthread_create(&workers[w].thread, NULL, launcher_worker_run, &workers[w]) != 0) {
+      fprintf(stderr, "Cannot create worker thread.\n");
+      exit(EXIT_FAILURE);
     }
-    // for(i = 0; i < DE_N; i++){
-    //   for(j = 0; j < dimension; j++){
-    //     printf("%.30lf ", population[i][j]);
-    //   }
-    //   printf("\n");
-    // }
-    // printf("%d\n", evaluation);
   }
-
-  my_evaluate_func(problem->best_solution, functions_values, function_name, dimension, problem->optimal);
-  
-  my_evaluate_func(population[min_pos], tmp_functions_values, function_name, dimension, problem->optimal);
-  // printf("best_solution:");
-  if(functions_values[0] > tmp_functions_values[0]){
-    for(i = 0; i < dimension; i++){
-      problem->best_solution[i] = population[min_pos][i];
+  for (size_t w = 0; w < number_of_workers; w++) {
+    pthread_join(workers[w].thread, NULL);
+  }
+  for (size_t item = 0; item < launcher.number_of_problem * number_of_variants; item++) {
+    if (launcher.seconds[item] >= 0) {
+      total += launcher.seconds[item];
+      done++;
     }
   }
+  if (number_of_workers > 0) {
+    printf("makespan %.1f s, ideal %.1f s\n", launcher_clock() - start, total / (double)number_of_workers);
+  }
+  if (!plan_only && done < launcher.number_of_items) {
+    printf("stopped early: %lu of %lu work items done, %s\n", (unsigned long)done,
+           (unsigned long)launcher.number_of_items,
+           campaign_stop_signal ? "on a signal" : "before the deadline");
+  }
+  if (timing_path != NULL && !plan_only) {
+    write_timing_report(&launcher, timing_path);
+  }
+  if (launcher.results != NULL && !plan_only) {
+    write_sweep_table(&launcher, sweep_table_path);
+  }
 
-  problem->end_flag = 0;
-  problem->evaluation_cnt += evaluation;
-  //fclose(fp);
-  //memory free
-  for (i = 0; i < DE_N; ++i) {
-    coco_free_memory(population[i]);
-    coco_free_memory(trial[i]);
-    coco_free_memory(tmp[i]);
-  }
-  free(population);
-  coco_free_memory(functions_values);
-  coco_free_memory(tmp_functions_values);
-  coco_free_memory(mutate);
-  coco_free_memory(tmp);
-  coco_free_memory(rnd_vals);
-  coco_free_memory(sum);
-  coco_free_memory(sum2);
+  if (launcher.runtime_file != NULL && (ferror(launcher.runtime_file) || fclose(launcher.runtime_file) != 0)) {
+    fprintf(stderr, "Cannot write runtimes %s.\n", runtime_path);
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < launcher.number_of_problem; i++) {
+    free_problem(&launcher.problems[i]);
+  }
+  free(launcher.problems);
+  close_catalog();
+  if (launcher.results != NULL) {
+    coco_free_memory(launcher.results);
+  }
+  coco_free_memory(launcher.seconds);
+  coco_free_memory(launcher.expected);
+  coco_free_memory(launcher.order);
+  coco_free_memory(topology.cpus);
 }
 
-//MY_EVALUATE_FUNC
-// void f1(const double *x, double *y, size_t dimension, double* optimal) {//sphere
-//   y[0] = 0;
-//   for(size_t i = 0; i < dimension; i++){
-//     y[0] += (optimal[i] - x[i])*(optimal[i] - x[i]);
-//   }
-// }
-
-// void f2(const double *x, double *y, size_t dimension, double* optimal) {//sphere
-//   y[0] = 0;
-//   for(size_t i = 0; i < dimension; i++){
-//     y[0] += pow(10, 6*i/(dimension - 1)) * (optimal[i] - x[i])*(optimal[i] - x[i]);
-//   }
+// MyCOCO
+void free_problem(MY_PROBLEM* problem) {
+    // 共有カタログ上の配列は解放しない
+    if (problem->mapped) {
+        free(problem->best_solution);
+        my_problem_release(problem);
+        return;
+    }
 
-//   y[0] = pow(10, -3) * y[0];
-// }
+    // function_name のメモリ解放
+    if (problem->function_name) {
+        free(problem->function_name);
+    }
 
-// void f3(const double *x, double *y, size_t dimension, double* optimal) {//rastrigin
-//   y[0] = 0;
-//   for(size_t i = 0; i < dimension; i++){
-//     y[0] += (optimal[i] - x[i])*(optimal[i] - x[i]) - 10*cos(2*M_PI*(optimal[i] - x[i]));
-//   }
+    // smallest 配列のメモリ解放
+    if (problem->smallest) {
+        free(problem->smallest);
+    }
 
-//   y[0] += 10*(double)dimension;
+    // largest 配列のメモリ解放
+    if (problem->largest) {
+        free(problem->largest);
+    }
 
-//   y[0] = 0.1 * y[0];
-// }
+    // optimal 配列のメモリ解放
+    if (problem->optimal) {
+        free(problem->optimal);
+    }
 
-// void f8(const double *x, double *y, size_t dimension, double* optimal) {//rosenbrock
-//   y[0] = 0;
-//   for(size_t i = 0; i < dimension - 1; i++){
-//     y[0] += 100*((optimal[i + 1] - x[i + 1]) - (optimal[i] - x[i]) * (optimal[i] - x[i]))*((optimal[i + 1] - x[i + 1]) - (optimal[i] - x[i]) * (optimal[i] - x[i])) + (optimal[i] - x[i] - 1)*(optimal[i] - x[i] - 1);
-//   }
-// }
+    // best_solution 配列のメモリ解放
+    if (problem->best_solution) {
+        free(problem->best_solution);
+    }
 
-static double f_sphere_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  size_t i = 0;
-  double result = 0.0;
-  double shifted_x;
+    my_problem_release(problem);
+}
 
-  for (i = 0; i < number_of_variables; ++i) {
-    shifted_x = x[i] - opt[i];
-    result += shifted_x * shifted_x;
+/**
+ * Built-in variable layout: the first dimension*r/5 variables are integer in [0, range], the others
+ * are continuous in [-5, 5].
+ */
+static int default_declare_variables(size_t dimension, size_t r, double range, int *is_integer, double *lower_bounds, double *upper_bounds){
+  for(size_t j = 0; j < dimension; j++){
+    if(j < dimension*r/5){
+      is_integer[j] = 1;
+      lower_bounds[j] = 0;
+      upper_bounds[j] = range;
+    }
+    else{
+      is_integer[j] = 0;
+      lower_bounds[j] = -5;
+      upper_bounds[j] = 5;
+    }
   }
-
-  return result;
+  return 0;
 }
 
-static double f_ellipsoid_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  static const double condition = 1.0e6;
-  size_t i = 0;
-  double result;
-  double shifted_x;
+/**
+ * Fills one catalog entry. Returns 0 on success and a non-zero value if the function does not
+ * provide this combination, in which case nothing is allocated.
+ */
+static int init_problem_entry(MY_PROBLEM *problem, const my_plugin_function_t *function, size_t r, double range, size_t dimension, size_t instance, int *is_integer, coco_random_state_t *random_generator){
+  int (*declare_variables)(size_t, size_t, double, int *, double *, double *) = function->declare_variables;
+  if(declare_variables == NULL){
+    declare_variables = default_declare_variables;
+  }
 
-  result = (x[0] - opt[0]) * (x[0] - opt[0]);
-  for (i = 1; i < number_of_variables; ++i) {
-    double exponent = 1.0 * (double)(long)i / ((double)(long)number_of_variables - 1.0);
-    shifted_x = x[i] - opt[i];
-    result += pow(condition, exponent) * shifted_x * shifted_x;
+  // optimalとsmallest と largest のメモリを確保
+  problem->smallest = (double*)malloc(dimension * sizeof(double));
+  problem->largest = (double*)malloc(dimension * sizeof(double));
+  if (!problem->smallest || !problem->largest) {
+    fprintf(stderr, "Memory allocation failed for arrays.\n");
+    exit(EXIT_FAILURE);
+  }
+  if(declare_variables(dimension, r, range, is_integer, problem->smallest, problem->largest) != 0){
+    free(problem->smallest);
+    free(problem->largest);
+    return 1;
+  }
+  problem->number_of_integer_variables = 0;
+  while(problem->number_of_integer_variables < dimension && is_integer[problem->number_of_integer_variables]){
+    problem->number_of_integer_variables++;
+  }
+  for(size_t j = 0; j < dimension; j++){
+    if(is_integer[j] && j >= problem->number_of_integer_variables){
+      fprintf(stderr, "%s: integer variable %lu follows a continuous one, integer variables must come first.\n", function->function_name, (unsigned long)j);
+      exit(EXIT_FAILURE);
+    }
+    // the encodings assume these bounds for the integer and the continuous block
+    if((is_integer[j] && (problem->smallest[j] != 0 || problem->largest[j] < 1 || problem->largest[j] >= 40 || problem->largest[j] != (int)problem->largest[j]))
+       || (!is_integer[j] && (problem->smallest[j] != -5 || problem->largest[j] != 5))){
+      fprintf(stderr, "%s: variable %lu has bounds [%f, %f] not supported by the encodings.\n", function->function_name, (unsigned long)j, problem->smallest[j], problem->largest[j]);
+      exit(EXIT_FAILURE);
+    }
   }
 
-  return result;
+  problem->function_name = (char*)malloc(strlen(function->function_name) + 1);
+  if (!problem->function_name) {
+      fprintf(stderr, "Memory allocation failed for function_name.\n");
+      exit(EXIT_FAILURE);
+  }
+  strcpy(problem->function_name, function->function_name);
+  problem->function = function;
+  problem->evaluate = select_evaluate(function, dimension);
+  problem->integer_table = NULL;
+  problem->table_evaluate = NULL;
+  problem->mapped = 0;
+  problem->rotation = NULL;
+  problem->rotation_scratch = NULL;
+  problem->gallagher = NULL;
+  problem->dimension = dimension;
+  problem->instance = instance;
+  problem->evaluation_cnt = 0;
+  problem->end_flag = 0;
+  problem->r = r;
+  for(size_t i = 0; i < NUMBER_OF_TARGET; i++){
+    problem->evaluate_result[i] = -1;
+    problem->first_hit[i] = -1;
+  }
+  problem->optimal = (double*)malloc(dimension * sizeof(double));
+  problem->best_solution = (double*)malloc(dimension * sizeof(double));
+  if (!problem->optimal || !problem->best_solution) {
+    fprintf(stderr, "Memory allocation failed for arrays.\n");
+    exit(EXIT_FAILURE);
+  }
+  for(size_t j = 0; j < dimension; j++){
+    problem->best_solution[j] = 100;
+  }
+  for(size_t j = 0; j < dimension; j++){
+    if(j < problem->number_of_integer_variables){
+      problem->optimal[j] = (int)(coco_random_uniform(random_generator) * (problem->largest[j] - problem->smallest[j] + 1) + problem->smallest[j]);
+    }
+    else{
+      problem->optimal[j] = problem->smallest[j] + coco_random_uniform(random_generator) * (problem->largest[j] - problem->smallest[j]);
+    }
+  }
+  return 0;
 }
 
-static double f_rastrigin_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  size_t i = 0;
-  double result;
-  double sum1 = 0.0, sum2 = 0.0;
-  double shifted_x;
-
-  for (i = 0; i < number_of_variables; ++i) {
-    shifted_x = x[i] - opt[i];
-    sum1 += cos(coco_two_pi * shifted_x);
-    sum2 += shifted_x * shifted_x;
+/**
+ * Stores the built-in functions of the comma-separated list suite_functions (--functions) and
+ * returns their number.
+ */
+static size_t select_suite_functions(const my_plugin_function_t **functions){
+  char name[CATALOG_FUNCTION_NAME_LENGTH];
+  const char *p = suite_functions;
+  size_t count = 0;
+
+  while(*p != '\0'){
+    size_t length = strcspn(p, ",");
+    if(length == 0 || length >= sizeof(name)){
+      fprintf(stderr, "Invalid function list %s.\n", suite_functions);
+      exit(EXIT_FAILURE);
+    }
+    if(count == MAX_SUITE_FUNCTIONS){
+      fprintf(stderr, "Too many functions (at most %d).\n", MAX_SUITE_FUNCTIONS);
+      exit(EXIT_FAILURE);
+    }
+    memcpy(name, p, length);
+    name[length] = '\0';
+    functions[count] = find_builtin_function(name);
+    if(functions[count] == NULL){
+      fprintf(stderr, "%s is not a built-in function.\n", name);
+      exit(EXIT_FAILURE);
+    }
+    for(size_t i = 0; i < count; i++){
+      if(functions[i] == functions[count]){
+        fprintf(stderr, "Function %s is selected twice.\n", name);
+        exit(EXIT_FAILURE);
+      }
+    }
+    count++;
+    p += length;
+    if(*p == ','){
+      p++;
+    }
   }
-
-  if (sum2 > 1e22) /* cos(inf) -> nan */
-    return sum2;
-
-  result = 10.0 * ((double)(long)number_of_variables - sum1) + sum2;
-
-  return result;
+  if(count == 0){
+    fprintf(stderr, "No function selected.\n");
+    exit(EXIT_FAILURE);
+  }
+  return count;
 }
 
-static double f_rosenbrock_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  size_t i = 0;
-  double result;
-  double s1 = 0.0, s2 = 0.0, tmp;
+MY_PROBLEM* init_problem(coco_random_state_t *random_generator, size_t *number_of_problem){
+  // 各問題を初期化(func)
+  const my_plugin_function_t *function[MAX_SUITE_FUNCTIONS];
+  size_t number_of_suite_functions = select_suite_functions(function);
+  size_t dimension[] = {5, 10, 20, 40, 80, 160};
+  double range[] = {2, 3, 4, 5, 6, 7, 8, 9, 10};
+  size_t ladder_size = 4 * (sizeof(range) / sizeof(range[0])) * (sizeof(dimension) / sizeof(dimension[0])) * 15;
+  size_t number_of_functions = number_of_suite_functions;
+  size_t problem_cnt = 0;
+  double amount = -2;
+  int is_integer[160]; //largest dimension of the ladder
 
-  for (i = 0; i < number_of_variables - 1; ++i) {
-    tmp = ((x[i] - opt[i]) * (x[i] - opt[i]) - (x[i + 1] - opt[i + 1]));
-    s1 += tmp * tmp;
-    tmp = (x[i] - opt[i] - 1.0);
-    s2 += tmp * tmp;
+  for(size_t plugin_cnt = 0; plugin_cnt < number_of_plugins; plugin_cnt++){
+    number_of_functions += plugins[plugin_cnt]->number_of_functions;
+  }
+  // built-in functions first, so that loading plugins does not change the built-in instances
+  const my_plugin_function_t **functions = (const my_plugin_function_t**)malloc(number_of_functions * sizeof(*functions));
+  MY_PROBLEM* problems = (MY_PROBLEM*)malloc(number_of_functions * ladder_size * sizeof(MY_PROBLEM));
+  if (!functions || !problems) {
+      fprintf(stderr, "Memory allocation failed for MY_PROBLEM.\n");
+      exit(EXIT_FAILURE);
+  }
+  number_of_functions = 0;
+  for(size_t func_cnt = 0; func_cnt < number_of_suite_functions; func_cnt++){
+    functions[number_of_functions++] = function[func_cnt];
+  }
+  for(size_t plugin_cnt = 0; plugin_cnt < number_of_plugins; plugin_cnt++){
+    for(size_t func_cnt = 0; func_cnt < plugins[plugin_cnt]->number_of_functions; func_cnt++){
+      functions[number_of_functions++] = &plugins[plugin_cnt]->functions[func_cnt];
+    }
   }
-  result = 100.0 * s1 + s2;
 
-  return result;
-}
+  for(size_t func_cnt = 0; func_cnt < number_of_functions; func_cnt++){
+    for(size_t r_cnt = 1; r_cnt < 5; r_cnt++){
+      for(size_t range_cnt = 0; range_cnt < sizeof(range) / sizeof(range[0]); range_cnt++){
+        for(size_t dimension_cnt = 0; dimension_cnt < sizeof(dimension) / sizeof(dimension[0]); dimension_cnt++){
+          for (size_t instance_count = 0; instance_count < 15; instance_count++){
+            if(init_problem_entry(&problems[problem_cnt], functions[func_cnt], r_cnt, range[range_cnt], dimension[dimension_cnt], instance_count, is_integer, random_generator) == 0){
+              problem_cnt++;
+            }
+          }
+        }
+      }
+    }
+  }
+  for(int target_cnt = 0; target_cnt < NUMBER_OF_TARGET; target_cnt++){
+    target[target_cnt] = pow(10, -amount);
+    amount += 0.2;
+  }
 
-static double f_bent_cigar_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  static const double condition = 1.0e6;
-  size_t i;
-  double result;
-  double shifted_x;
+  free(functions);
+  *number_of_problem = problem_cnt;
+  return problems;
+}
 
-  result = (x[0] - opt[0]) * (x[0] - opt[0]);
-  for (i = 1; i < number_of_variables; ++i) {
-    shifted_x = x[i] - opt[i];
-    result += condition * shifted_x * shifted_x;
+static size_t number_of_plugin_functions(void){
+  size_t count = 0;
+  for(size_t i = 0; i < number_of_plugins; i++){
+    count += plugins[i]->number_of_functions;
   }
-
-  return result;
+  return count;
 }
 
-static double f_sharp_ridge_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  static const double alpha = 100.0;
-  const double d_vars_40 = 1.0; /* generalized: number_of_variables <= 40 ? 1 : number_of_variables / 40.0; */
-  const size_t vars_40 = 1;
-  size_t i = 0;
-  double result = 0.0;
-  double shifted_x;
+/**
+ * Writes the catalog of the problems to path. The file is written under a temporary name and
+ * renamed, so processes that open the catalog concurrently see either no file or the whole file.
+ */
+static void write_catalog(const char *path, const MY_PROBLEM *problems, size_t number_of_problem){
+  char tmp_path[1024];
+  catalog_header_t header;
+  catalog_record_t record;
+  uint64_t offset = 0;
+  FILE *fp;
 
-  for (i = vars_40; i < number_of_variables; ++i) {
-    shifted_x = x[i] - opt[i];
-    result += shifted_x * shifted_x;
+  if(snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(tmp_path)){
+    fprintf(stderr, "Catalog path %s is too long.\n", path);
+    exit(EXIT_FAILURE);
   }
-  result = alpha * sqrt(result / d_vars_40);
-  for (i = 0; i < vars_40; ++i) {
-    shifted_x = x[i] - opt[i];
-    result += shifted_x * shifted_x / d_vars_40;
+  fp = fopen(tmp_path, "wb");
+  if(fp == NULL){
+    fprintf(stderr, "Cannot write catalog %s: %s\n", tmp_path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+  header.version = CATALOG_VERSION;
+  header.number_of_target = NUMBER_OF_TARGET;
+  header.random_seed = RANDOM_SEED;
+  header.number_of_plugin_functions = (uint32_t)number_of_plugin_functions();
+  header.number_of_problem = number_of_problem;
+  header.data_offset = sizeof(header) + NUMBER_OF_TARGET * sizeof(double) + number_of_problem * sizeof(catalog_record_t);
+  fwrite(&header, sizeof(header), 1, fp);
+  fwrite(target, sizeof(double), NUMBER_OF_TARGET, fp);
+  for(size_t i = 0; i < number_of_problem; i++){
+    if(strlen(problems[i].function_name) >= CATALOG_FUNCTION_NAME_LENGTH){
+      fprintf(stderr, "Function name %s is too long for the catalog.\n", problems[i].function_name);
+      exit(EXIT_FAILURE);
+    }
+    memset(&record, 0, sizeof(record));
+    strcpy(record.function_name, problems[i].function_name);
+    record.r = problems[i].r;
+    record.number_of_integer_variables = problems[i].number_of_integer_variables;
+    record.dimension = problems[i].dimension;
+    record.instance = problems[i].instance;
+    record.offset = offset;
+    offset += 3 * problems[i].dimension;
+    fwrite(&record, sizeof(record), 1, fp);
+  }
+  for(size_t i = 0; i < number_of_problem; i++){
+    fwrite(problems[i].smallest, sizeof(double), problems[i].dimension, fp);
+    fwrite(problems[i].largest, sizeof(double), problems[i].dimension, fp);
+    fwrite(problems[i].optimal, sizeof(double), problems[i].dimension, fp);
+  }
+  if(ferror(fp) || fclose(fp) != 0 || rename(tmp_path, path) != 0){
+    fprintf(stderr, "Cannot write catalog %s: %s\n", path, strerror(errno));
+    remove(tmp_path);
+    exit(EXIT_FAILURE);
   }
-
-  return result;
 }
 
-static double f_different_powers_raw(const double *x, const size_t number_of_variables, const double *opt) {
-  size_t i;
-  double sum = 0.0;
-  double result;
-  double shifted_x;
-
-  for (i = 0; i < number_of_variables; ++i) {
-    double exponent = 2.0 + (4.0 * (double)(long)i) / ((double)(long)number_of_variables - 1.0);
-    shifted_x = x[i] - opt[i];
-    sum += pow(fabs(shifted_x), exponent);
+/**
+ * Returns the problems of the catalog file at path, which is memory-mapped read-only so that all
+ * experiment processes share the bounds and optima of the same instances. If the file does not
+ * exist, the problems are generated by init_problem and the catalog is written.
+ *
+ * init_problem draws one uniform number per coordinate of every problem and the DE runs continue
+ * with the same random_generator, so the draws are replayed for a mapped catalog and the runs are
+ * the same as without catalog.
+ */
+MY_PROBLEM* open_catalog(const char *path, coco_random_state_t *random_generator, size_t *number_of_problem){
+  const catalog_header_t *header;
+  const catalog_record_t *records;
+  const double *data;
+  MY_PROBLEM *problems;
+  struct stat st;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if(fd < 0 && errno == ENOENT){
+    printf("generating problem...\n");
+    problems = init_problem(random_generator, number_of_problem);
+    write_catalog(path, problems, *number_of_problem);
+    printf("success generation, catalog written to %s\n", path);
+    return problems;
+  }
+  if(fd < 0 || fstat(fd, &st) != 0){
+    fprintf(stderr, "Cannot open catalog %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  catalog_size = (size_t)st.st_size;
+  if(catalog_size < sizeof(catalog_header_t)){
+    fprintf(stderr, "Catalog %s is truncated.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  catalog_map = mmap(NULL, catalog_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(catalog_map == MAP_FAILED){
+    fprintf(stderr, "Cannot map catalog %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
   }
-  result = sqrt(sum);
-
-  return result;
-}
+
+  header = (const catalog_header_t *)catalog_map;
+  if(memcmp(header->magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0 || header->version != CATALOG_VERSION){
+    fprintf(stderr, "%s is not a catalog of version %d.\n", path, CATALOG_VERSION);
+    exit(EXIT_FAILURE);
+  }
+  if(header->number_of_target != NUMBER_OF_TARGET || header->random_seed != RANDOM_SEED
+     || header->number_of_plugin_functions != number_of_plugin_functions()){
+    fprintf(stderr, "Catalog %s was generated with other settings or plugins, remove it to regenerate it.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  records = (const catalog_record_t *)((const char *)catalog_map + sizeof(catalog_header_t) + NUMBER_OF_TARGET * sizeof(double));
+  data = (const double *)((const char *)catalog_map + header->data_offset);
+  if(header->data_offset > catalog_size
+     || header->data_offset != sizeof(catalog_header_t) + NUMBER_OF_TARGET * sizeof(double) + header->number_of_problem * sizeof(catalog_record_t)
+     || (header->number_of_problem > 0 && (catalog_size - header->data_offset) / sizeof(double) < records[header->number_of_problem - 1].offset + 3 * records[header->number_of_problem - 1].dimension)){
+    fprintf(stderr, "Catalog %s is truncated.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  {
+    /* every problem must be of a selected function and every selected function must have problems */
+    const my_plugin_function_t *selected[MAX_SUITE_FUNCTIONS];
+    size_t number_of_selected = select_suite_functions(selected);
+    int found[MAX_SUITE_FUNCTIONS] = {0};
+    for(size_t i = 0; i < header->number_of_problem; i++){
+      const my_plugin_function_t *function = find_function(records[i].function_name);
+      size_t k = 0;
+      while(k < number_of_selected && selected[k] != function){
+        k++;
+      }
+      if(k < number_of_selected){
+        found[k] = 1;
+      }
+      else if(find_builtin_function(records[i].function_name) != NULL){
+        fprintf(stderr, "Catalog %s has problems of %s, which is not in the function list %s; remove it to regenerate it.\n", path, records[i].function_name, suite_functions);
+        exit(EXIT_FAILURE);
+      }
+    }
+    for(size_t k = 0; k < number_of_selected; k++){
+      if(!found[k]){
+        fprintf(stderr, "Catalog %s has no problems of %s; remove it to regenerate it.\n", path, selected[k]->function_name);
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+  memcpy(target, (const char *)catalog_map + sizeof(catalog_header_t), sizeof(target));
+
+  *number_of_problem = (size_t)header->number_of_problem;
+  problems = (MY_PROBLEM*)malloc(*number_of_problem * sizeof(MY_PROBLEM));
+  if(!problems){
+    fprintf(stderr, "Memory allocation failed for MY_PROBLEM.\n");
+    exit(EXIT_FAILURE);
+  }
+  for(size_t i = 0; i < *number_of_problem; i++){
+    const catalog_record_t *record = &records[i];
+    MY_PROBLEM *problem = &problems[i];
+    const double *values = data + record->offset;
+
+    problem->function = find_function(record->function_name);
+    problem->function_name = (char *)record->function_name;
+    problem->r = (size_t)record->r;
+    problem->number_of_integer_variables = (size_t)record->number_of_integer_variables;
+    problem->dimension = (size_t)record->dimension;
+    problem->instance = (size_t)record->instance;
+    problem->smallest = (double *)values;
+    problem->largest = (double *)(values + problem->dimension);
+    problem->optimal = (double *)(values + 2 * problem->dimension);
+    problem->evaluate = select_evaluate(problem->function, problem->dimension);
+    problem->integer_table = NULL;
+    problem->table_evaluate = NULL;
+    problem->mapped = 1;
+    problem->rotation = NULL;
+    problem->rotation_scratch = NULL;
+    problem->gallagher = NULL;
+    problem->evaluation_cnt = 0;
+    problem->end_flag = 0;
+    for(size_t j = 0; j < NUMBER_OF_TARGET; j++){
+      problem->evaluate_result[j] = -1;
+      problem->first_hit[j] = -1;
+    }
+    problem->best_solution = coco_allocate_vector(problem->dimension);
+    for(size_t j = 0; j < problem->dimension; j++){
+      problem->best_solution[j] = 100;
+      coco_random_uniform(random_generator);
+    }
+  }
+  return problems;
+}
+
+void close_catalog(void){
+  if(catalog_map != NULL){
+    munmap(catalog_map, catalog_size);
+    catalog_map = NULL;
+    catalog_size = 0;
+  }
+}
+
+/**
+ * Range directory of the result files of the problem: the upper bound of the integer variables,
+ * or 6 for [0,1].
+ */
+int my_problem_range(const MY_PROBLEM *problem){
+  if((int)problem->largest[0] == 1){
+    return 6;
+  }
+  return (int)problem->largest[0];
+}
+
+//RUNTIMES
+FILE *open_runtimes(const char *path){
+  runtime_header_t header;
+  FILE *fp = fopen(path, "wb");
+
+  if(fp == NULL){
+    fprintf(stderr, "Cannot write runtimes %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, RUNTIME_MAGIC, sizeof(RUNTIME_MAGIC));
+  header.number_of_target = NUMBER_OF_TARGET;
+  header.budget_multiplier = budget_multiplier;
+  fwrite(&header, sizeof(header), 1, fp);
+  fwrite(target, sizeof(double), NUMBER_OF_TARGET, fp);
+  return fp;
+}
+
+/**
+ * Writes the result file of the problem: for every log10(evaluations / dimension) from 0 to 4 by
+ * 0.001, the number of targets hit within that many evaluations.
+ */
+void write_result_file(FILE *fp, const MY_PROBLEM *problem){
+  const size_t dimension = problem->dimension;
+  double amount = 0;
+  size_t target_count = 0;
+
+  while(1){
+    if(amount > 4){
+      break;
+    }
+    for(int k = 0; k < NUMBER_OF_TARGET; k++){
+      if(((double)dimension*pow(10, amount) >= (double)(double)problem->evaluate_result[k] ) && (problem->evaluate_result[k] != -1)){
+        target_count++;
+      }
+      else{
+        break;
+      }
+    }
+    fprintf(fp,"%f %ld\n", amount, target_count);
+    target_count = 0;
+    amount += 0.001;
+  }
+}
+
+void write_runtime_record(FILE *fp, const MY_PROBLEM *problem, const de_variant_t *variant){
+  runtime_record_t record;
+
+  if(strlen(problem->function_name) >= CATALOG_FUNCTION_NAME_LENGTH || strlen(variant->name) >= RUNTIME_VARIANT_LENGTH){
+    fprintf(stderr, "Name %s/%s is too long for the runtime file.\n", problem->function_name, variant->name);
+    exit(EXIT_FAILURE);
+  }
+  memset(&record, 0, sizeof(record));
+  strcpy(record.function_name, problem->function_name);
+  strcpy(record.variant, variant->name);
+  record.r = problem->r;
+  record.range = (uint64_t)my_problem_range(problem);
+  record.dimension = problem->dimension;
+  record.instance = problem->instance;
+  record.evaluations = problem->evaluation_cnt;
+  for(size_t i = 0; i < NUMBER_OF_TARGET; i++){
+    record.evaluate_result[i] = problem->evaluate_result[i];
+    record.first_hit[i] = problem->first_hit[i];
+  }
+  fwrite(&record, sizeof(record), 1, fp);
+}
+
+//EA_DEFAULT_PARTS
+/*
+ * The functions with the suffix _impl are templates: encoding and approach are compile-time
+ * constants in every instantiation generated by DE_DEFINE_VARIANT, so the tests on them are
+ * resolved by the compiler and do not run per individual or per coordinate. The fixed-dimension
+ * instantiations also pass the dimension as a constant, so the coordinate loops get
+ * compile-time trip counts.
+ *
+ * Integer variables are the first number_of_integer_variables coordinates and continuous
+ * variables the rest, so every kernel runs one loop per block instead of testing the type of
+ * each coordinate.
+ */
+static FORCE_INLINE void ea_group_initialization_impl(double** population, size_t population_size, size_t dimension, size_t number_of_integer_variables, const double* lower_bounds, const double* upper_bounds, coco_random_state_t *random_generator, const int encoding){
+  //initialization
+  for (size_t i = 0; i < population_size; i++) {
+    if(encoding == 0){
+      for (int j = 0; j < dimension; j++) {
+        double range = upper_bounds[j] - lower_bounds[j];
+        population[i][j] = lower_bounds[j] + coco_random_uniform(random_generator) * range;
+      }
+    }
+    else if(encoding == 1){
+      for (int j = 0; j < dimension; j++) {
+        population[i][j] = coco_random_uniform(random_generator);
+      }
+    }
+    else if(encoding == 2){
+      for (size_t j = 0; j < number_of_integer_variables; j++) {
+        double range = (upper_bounds[j] + 0.5 - FLT_EPSILON) - (lower_bounds[j] - 0.5);
+        population[i][j] = lower_bounds[j] - 0.5 + coco_random_uniform(random_generator) * range;
+      }
+      for (size_t j = number_of_integer_variables; j < dimension; j++) {
+        double range = upper_bounds[j] - lower_bounds[j];
+        population[i][j] = lower_bounds[j] + coco_random_uniform(random_generator) * range;
+      }
+    }
+  }
+}
+
+/**
+ * Rounds the integer block to the nearest value of {0, ..., upper_bounds[i]}, comparing absolute
+ * values and preferring the larger value on ties.
+ */
+static FORCE_INLINE void round_vec_impl(double *x, size_t number_of_integer_variables, const double *upper_bounds){
+  for(int i = 0; i < number_of_integer_variables; i++){
+    double a = fabs(x[i]);
+    double y_star = floor(a);
+    y_star += (a - y_star >= 0.5) ? 1.0 : 0.0;
+    x[i] = y_star < upper_bounds[i] ? y_star : upper_bounds[i];
+  }
+}
+
+static FORCE_INLINE void decoding_vec_impl(double *x, size_t dimention_size, size_t number_of_integer_variables, const double *upper_bounds){
+  for(size_t i = 0; i < number_of_integer_variables; i++){
+    double value = floor(x[i]*(upper_bounds[i] + 1));
+    x[i] = value > upper_bounds[i] ? upper_bounds[i] : value;
+  }
+  for(size_t i = number_of_integer_variables; i < dimention_size; i++){
+    x[i] =  10.0 * x[i] - 5.0;
+  }
+}
+
+/**
+ * Returns the smallest j in {1, ..., upper + 1} with x < y_j, where y_j = j/(upper + 1) are the
+ * auxiliary values of the new encoding, or upper + 2 if there is none. The estimate from
+ * x*(upper + 1) is corrected against y_j computed exactly as before, so the result does not
+ * depend on the rounding of the estimate.
+ */
+static FORCE_INLINE int new_round_index(double x, double upper){
+  const double step = 1/(upper + 1);
+  const int last = (int)upper + 1;
+  double estimate = x * (upper + 1);
+  int j = estimate < 1 ? 1 : (estimate > last ? last + 1 : (int)estimate + 1);
+
+  while(j > 1 && x < step * (j - 1)){
+    j--;
+  }
+  while(j <= last && !(x < step * j)){
+    j++;
+  }
+  return j;
+}
+
+static FORCE_INLINE void new_round_vec_impl(double *x, size_t number_of_integer_variables, const double *upper_bounds, const int approach){
+  for(int i = 0; i < number_of_integer_variables; i++){
+    const double step = 1/(upper_bounds[i] + 1);
+    const int last = (int)upper_bounds[i] + 1;
+    int j = new_round_index(x[i], upper_bounds[i]);
+    if(j > last){
+      continue;
+    }
+
+    //整数型の丸め
+    if(approach == 0){//U-Lf
+      if(j == 1){
+        x[i] = 0;
+      }
+      else if(j == last){
+        x[i] = 1;
+      }
+      else{
+        x[i] = step * (j - 1) + 1/((upper_bounds[i] + 1)*2);
+      }
+    }
+    else if(approach == 1){//U-Lm
+      x[i] = step * (j - 1) + 1/((upper_bounds[i] + 1)*2);
+    }
+    else if(approach == 2){//U-Lb
+      if(fabs(x[i] - step * j) < fabs(x[i] - step * (j - 1))){
+        x[i] = step * j - FLT_EPSILON;
+      }
+      else{
+        x[i] = step * (j - 1);
+      }
+    }
+  }
+}
+
+static FORCE_INLINE void ea_group_encoding_impl(double** x, double** tmp, size_t number_of_points, size_t dimension, size_t number_of_integer_variables, const double* upper_bounds, const int encoding, const int approach){
+  if((encoding == 0 && approach == 1) || (encoding == 1 && approach == 3) || (encoding == 2 && approach == 1)){
+    for (size_t i = 0; i < number_of_points; i++) {
+      for(int j = 0; j < dimension; j++){
+        tmp[i][j] = x[i][j];
+      }
+    }
+  }
+  for (size_t i = 0; i < number_of_points; i++) {
+    if(encoding == 0 || encoding == 2){
+      if(approach == 0){
+        round_vec_impl(x[i],number_of_integer_variables,upper_bounds);
+        for(int j = 0; j < dimension; j++){
+          tmp[i][j] = x[i][j];
+        }
+      }
+      else if(approach == 1){
+        round_vec_impl(tmp[i],number_of_integer_variables,upper_bounds);
+      }
+    }
+    else{
+      if(approach == 0 || approach  == 1 || approach  == 2){
+        new_round_vec_impl(x[i], number_of_integer_variables, upper_bounds, approach);
+        for(int j = 0; j < dimension; j++){
+          tmp[i][j] = x[i][j];
+        }
+        decoding_vec_impl(tmp[i], dimension, number_of_integer_variables, upper_bounds);
+      }
+      else{
+        decoding_vec_impl(tmp[i], dimension, number_of_integer_variables, upper_bounds);
+      }
+    }
+  }
+}
+
+/**
+ * One generation of the DE: mutation with bound repair, binomial crossover and encoding of the
+ * trial vectors into workspace->tmp. The bound repair works on the search domain of the encoding
+ * precomputed by de_workspace_new, so it is the same select for every encoding and coordinate.
+ * N, CR and F are the ones of the workspace, so one instantiation serves every sweep configuration.
+ * If the integer block of the population is stored as codes, the mutation decodes it and takes the
+ * continuous block from population, and the individual is unpacked into workspace->parent.
+ */
+static FORCE_INLINE void de_generation_impl(de_workspace_t *workspace, size_t dimension, size_t number_of_integer_variables, const double* upper_bounds, coco_random_state_t *random_generator, const int encoding, const int approach){
+  double **population = workspace->population;
+  double **trial = workspace->trial;
+  double *mutate = workspace->mutate;
+  double *rnd_vals = workspace->rnd_vals;
+  const double *repair_lower = workspace->repair_lower;
+  const double *repair_upper = workspace->repair_upper;
+  const size_t population_size = workspace->population_size;
+  const double n = (double)population_size;
+  const double cr = workspace->cr;
+  const double f = workspace->f;
+  int vector[3];
+  size_t i, j;
+
+  for (i = 0; i < population_size; i++) {
+    //selection
+    vector[0] = (int)(coco_random_uniform(random_generator)*n);
+    do {
+        vector[1] = (int)(coco_random_uniform(random_generator)*n);
+    } while (vector[1] == vector[0]);
+
+    do {
+        vector[2] = (int)(coco_random_uniform(random_generator)*n);
+    } while (vector[2] == vector[0] || vector[2] == vector[1]);
+    //mutation
+    const double *x0 = population[vector[0]];
+    const double *x1 = population[vector[1]];
+    const double *x2 = population[vector[2]];
+    const double *xi = population[i];
+    if(DE_COMPACT_POPULATION && DE_LAMARCKIAN(encoding, approach) && workspace->number_of_codes > 0){
+      const unsigned char *c0 = workspace->codes[vector[0]];
+      const unsigned char *c1 = workspace->codes[vector[1]];
+      const unsigned char *c2 = workspace->codes[vector[2]];
+      const unsigned char *ci = workspace->codes[i];
+      const size_t k = workspace->number_of_codes;
+      double *parent = workspace->parent;
+      for (j = 0; j < k; j++) {
+        const double *decode = workspace->decode[j];
+        double m = decode[c0[j]] + f * (decode[c1[j]] - decode[c2[j]]);
+        parent[j] = decode[ci[j]];
+        double below = (repair_lower[j] + parent[j]) / 2.0;
+        double above = (repair_upper[j] + parent[j]) / 2.0;
+        mutate[j] = m < repair_lower[j] ? below : (m > repair_upper[j] ? above : m);
+      }
+      for (j = k; j < dimension; j++) {
+        double m = x0[j - k] + f * (x1[j - k] - x2[j - k]);
+        parent[j] = xi[j - k];
+        double below = (repair_lower[j] + parent[j]) / 2.0;
+        double above = (repair_upper[j] + parent[j]) / 2.0;
+        mutate[j] = m < repair_lower[j] ? below : (m > repair_upper[j] ? above : m);
+      }
+      xi = parent;
+    }
+    else{
+      for (j = 0; j < dimension; j++) {
+        double m = x0[j] + f * (x1[j] - x2[j]);
+        double below = (repair_lower[j] + xi[j]) / 2.0;
+        double above = (repair_upper[j] + xi[j]) / 2.0;
+        mutate[j] = m < repair_lower[j] ? below : (m > repair_upper[j] ? above : m);
+      }
+    }
+    //crossover
+    int j_rand = (int)(coco_random_uniform(random_generator)*(int)dimension);
+
+    // Generate random values between 0 and 1
+    for (j = 0; j < dimension; j++) {
+        rnd_vals[j] = coco_random_uniform(random_generator);
+    }
+    // Set rnd_vals[j_rand] to 0.0
+    rnd_vals[j_rand] = 0.0;
+    // Perform binomial crossover
+    size_t *changed = workspace->changed[i];
+    size_t number_of_changed = 0;
+    for (j = 0; j < dimension; j++) {
+        trial[i][j] = rnd_vals[j] <= cr ? mutate[j] : xi[j];
+        changed[number_of_changed] = j;
+        number_of_changed += rnd_vals[j] <= cr;
+    }
+    workspace->number_of_changed[i] = number_of_changed;
+  }
+  //encoding
+  ea_group_encoding_impl(trial, workspace->tmp, population_size, dimension, number_of_integer_variables, upper_bounds, encoding, approach);
+}
+
+#define DE_DEFINE_FIXED_KERNELS(D, E, A) \
+  static void ea_group_encoding_##E##_##A##_##D(double **x, double **tmp, size_t number_of_points, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds) { \
+    (void)dimension; \
+    ea_group_encoding_impl(x, tmp, number_of_points, D, number_of_integer_variables, upper_bounds, E, A); \
+  } \
+  static void de_generation_##E##_##A##_##D(de_workspace_t *workspace, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds, coco_random_state_t *random_generator) { \
+    (void)dimension; \
+    de_generation_impl(workspace, D, number_of_integer_variables, upper_bounds, random_generator, E, A); \
+  }
+#define DE_DEFINE_VARIANT(E, A, NAME) \
+  static void ea_group_initialization_##E##_##A(double **population, size_t population_size, size_t dimension, size_t number_of_integer_variables, const double *lower_bounds, const double *upper_bounds, coco_random_state_t *random_generator) { \
+    ea_group_initialization_impl(population, population_size, dimension, number_of_integer_variables, lower_bounds, upper_bounds, random_generator, E); \
+  } \
+  static void ea_group_encoding_##E##_##A(double **x, double **tmp, size_t number_of_points, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds) { \
+    ea_group_encoding_impl(x, tmp, number_of_points, dimension, number_of_integer_variables, upper_bounds, E, A); \
+  } \
+  static void de_generation_##E##_##A(de_workspace_t *workspace, size_t dimension, size_t number_of_integer_variables, const double *upper_bounds, coco_random_state_t *random_generator) { \
+    de_generation_impl(workspace, dimension, number_of_integer_variables, upper_bounds, random_generator, E, A); \
+  } \
+  FIXED_DIMENSIONS(DE_DEFINE_FIXED_KERNELS, E, A)
+DE_VARIANTS(DE_DEFINE_VARIANT)
+#undef DE_DEFINE_VARIANT
+#undef DE_DEFINE_FIXED_KERNELS
+
+#define DE_FIXED_KERNELS_ENTRY(D, E, A) {D, ea_group_encoding_##E##_##A##_##D, de_generation_##E##_##A##_##D},
+#define DE_VARIANT_ENTRY(E, A, NAME) \
+  {E, A, NAME, DE_N, DE_CR, DE_F, ea_group_initialization_##E##_##A, { \
+    FIXED_DIMENSIONS(DE_FIXED_KERNELS_ENTRY, E, A) \
+    {0, ea_group_encoding_##E##_##A, de_generation_##E##_##A} \
+  }},
+static const de_variant_t de_variants[] = {
+  DE_VARIANTS(DE_VARIANT_ENTRY)
+};
+#undef DE_VARIANT_ENTRY
+#undef DE_FIXED_KERNELS_ENTRY
+
+/**
+ * Returns the built-in variant or the configuration of --sweep with the given name, or NULL.
+ */
+const de_variant_t *lookup_de_variant(const char *name){
+  for(size_t i = 0; i < sizeof(de_variants) / sizeof(de_variants[0]); i++){
+    if(strcmp(de_variants[i].name, name) == 0){
+      return &de_variants[i];
+    }
+  }
+  for(size_t k = 0; k < number_of_sweep_variants; k++){
+    if(strcmp(sweep_names[k], name) == 0){
+      return &sweep_variants[k];
+    }
+  }
+  return NULL;
+}
+
+const de_variant_t *find_de_variant(const char *name){
+  const de_variant_t *variant = lookup_de_variant(name);
+  if(variant == NULL){
+    fprintf(stderr, "Unknown DE variant %s.\n", name);
+    exit(EXIT_FAILURE);
+  }
+  return variant;
+}
+
+const de_variant_t *find_de_variant_by_code(int encoding, int approach){
+  for(size_t i = 0; i < sizeof(de_variants) / sizeof(de_variants[0]); i++){
+    if(de_variants[i].encoding == encoding && de_variants[i].approach == approach){
+      return &de_variants[i];
+    }
+  }
+  fprintf(stderr, "Unknown DE variant ENCODING=%d APPROACH=%d.\n", encoding, approach);
+  exit(EXIT_FAILURE);
+}
+
+/**
+ * Adds the configurations of a --sweep specification "variant:N:CR:F" to sweep_variants. Every
+ * field but the variant may be a comma-separated list, and the configurations are the cartesian
+ * product of the lists: U-Lb:50,100:0.5,0.9:0.5 adds four configurations of U-Lb. Several
+ * specifications add their grids one after the other. Configuration k is named <variant>-s<k> and
+ * shares the kernels of its variant, which take N, CR and F from the workspace.
+ */
+void sweep_add(const char *spec){
+  double values[3][SWEEP_MAX_VALUES];
+  size_t counts[3];
+  char name[RUNTIME_VARIANT_LENGTH];
+  const char *p = strchr(spec, ':');
+  de_variant_t base;
+
+  if(p == NULL || (size_t)(p - spec) >= sizeof(name)){
+    fprintf(stderr, "Bad --sweep %s, expected variant:N:CR:F.\n", spec);
+    exit(EXIT_FAILURE);
+  }
+  memcpy(name, spec, (size_t)(p - spec));
+  name[p - spec] = '\0';
+  base = *find_de_variant(name);
+  for(size_t k = 0; k < 3; k++){
+    counts[k] = 0;
+    do{
+      char *end;
+      if(counts[k] == SWEEP_MAX_VALUES){
+        fprintf(stderr, "Bad --sweep %s, at most %d values per field.\n", spec, SWEEP_MAX_VALUES);
+        exit(EXIT_FAILURE);
+      }
+      values[k][counts[k]++] = strtod(p + 1, &end);
+      if(end == p + 1){
+        fprintf(stderr, "Bad --sweep %s, expected variant:N:CR:F.\n", spec);
+        exit(EXIT_FAILURE);
+      }
+      p = end;
+    }while(*p == ',');
+    if(*p != (k < 2 ? ':' : '\0')){
+      fprintf(stderr, "Bad --sweep %s, expected variant:N:CR:F.\n", spec);
+      exit(EXIT_FAILURE);
+    }
+  }
+  for(size_t a = 0; a < counts[0]; a++){
+    for(size_t b = 0; b < counts[1]; b++){
+      for(size_t c = 0; c < counts[2]; c++){
+        const size_t k = number_of_sweep_variants;
+        const double population_size = values[0][a], cr = values[1][b], f = values[2][c];
+        /* the mutation draws three distinct individuals */
+        if(population_size < 3 || population_size != floor(population_size) || cr < 0 || cr > 1 || f <= 0){
+          fprintf(stderr, "Bad --sweep configuration N=%g CR=%g F=%g (N >= 3 integer, 0 <= CR <= 1, F > 0).\n",
+                  population_size, cr, f);
+          exit(EXIT_FAILURE);
+        }
+        if(k == MAX_SWEEP_CONFIGURATIONS){
+          fprintf(stderr, "Too many --sweep configurations (at most %d).\n", MAX_SWEEP_CONFIGURATIONS);
+          exit(EXIT_FAILURE);
+        }
+        if(snprintf(sweep_names[k], RUNTIME_VARIANT_LENGTH, "%s-s%lu", base.name, (unsigned long)k) >= RUNTIME_VARIANT_LENGTH){
+          fprintf(stderr, "Name of --sweep configuration %lu of %s is too long.\n", (unsigned long)k, base.name);
+          exit(EXIT_FAILURE);
+        }
+        sweep_variants[k] = base;
+        sweep_variants[k].name = sweep_names[k];
+        sweep_variants[k].population_size = (size_t)population_size;
+        sweep_variants[k].cr = cr;
+        sweep_variants[k].f = f;
+        sweep_list[k] = &sweep_variants[k];
+        number_of_sweep_variants++;
+      }
+    }
+  }
+}
+
+/**
+ * Returns the kernels of the variant instantiated for the dimension, or the generic ones.
+ */
+const de_kernels_t *de_select_kernels(const de_variant_t *variant, size_t dimension){
+  for(size_t i = 0; i < NUMBER_OF_FIXED_DIMENSIONS; i++){
+    if(variant->kernels[i].dimension == dimension){
+      return &variant->kernels[i];
+    }
+  }
+  return &variant->kernels[NUMBER_OF_FIXED_DIMENSIONS];
+}
+
+static int compare_code_values(const void *a, const void *b){
+  const double x = *(const double *)a, y = *(const double *)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * Writes to values, ascending and without repeats, every value the encoding step of the Lamarckian
+ * variants of the encoding can leave in an integer coordinate with this upper bound, computed by
+ * the same expressions as round_vec_impl and new_round_vec_impl, and returns their number: the
+ * integers 0, ..., upper for the encodings 0 and 2, and for the encoding 1 the values of U-Lf,
+ * U-Lm and U-Lb plus step * (upper + 1) and 1, which new_round_vec_impl leaves as they are.
+ */
+static size_t de_code_values(double *values, double upper, int encoding){
+  size_t n = 0, unique = 0;
+
+  if(encoding != 1){
+    for(int k = 0; k <= (int)upper; k++){
+      values[n++] = k;
+    }
+    return n;
+  }
+  const double step = 1/(upper + 1);
+  const int last = (int)upper + 1;
+  values[n++] = 0;
+  values[n++] = 1;
+  for(int k = 0; k <= last; k++){
+    values[n++] = step * k;
+    if(k > 0){
+      values[n++] = step * k - FLT_EPSILON;
+    }
+    if(k < last){
+      values[n++] = step * k + 1/((upper + 1)*2);
+    }
+  }
+  qsort(values, n, sizeof(double), compare_code_values);
+  for(size_t i = 0; i < n; i++){
+    if(unique == 0 || values[i] != values[unique - 1]){
+      values[unique++] = values[i];
+    }
+  }
+  return unique;
+}
+
+/**
+ * Allocates population, trial and encoded vectors of a DE run, with the population size of the
+ * variant, and the search domain of the encoding of the variant. If number_of_codes > 0, the
+ * variant is Lamarckian and the first number_of_codes coordinates are integer, these are stored as
+ * one byte codes into the values of de_code_values (see de_population_store), and population
+ * keeps the continuous block alone.
+ */
+de_workspace_t *de_workspace_new(size_t dimension, size_t number_of_codes, const double *lower_bounds, const double *upper_bounds, const de_variant_t *variant){
+  de_workspace_t *workspace = (de_workspace_t *)coco_allocate_memory(sizeof(*workspace));
+  const size_t population_size = variant->population_size;
+  const size_t stored = dimension - number_of_codes > 0 ? dimension - number_of_codes : 1;
+  workspace->population_size = population_size;
+  workspace->cr = variant->cr;
+  workspace->f = variant->f;
+  workspace->population = (double**)malloc(population_size * sizeof(double*));
+  workspace->trial = (double**)malloc(population_size * sizeof(double*));
+  workspace->tmp = (double**)malloc(population_size * sizeof(double*));
+  workspace->changed = (size_t**)malloc(population_size * sizeof(size_t*));
+  workspace->number_of_changed = (size_t*)malloc(population_size * sizeof(size_t));
+  if (!workspace->population || !workspace->trial || !workspace->tmp || !workspace->changed
+      || !workspace->number_of_changed) {
+    fprintf(stderr, "Memory allocation failed for de_workspace.\n");
+    exit(EXIT_FAILURE);
+  }
+  workspace->mutate = coco_allocate_vector(dimension);
+  workspace->rnd_vals = coco_allocate_vector(dimension);
+  workspace->repair_lower = coco_allocate_vector(dimension);
+  workspace->repair_upper = coco_allocate_vector(dimension);
+  workspace->parent = coco_allocate_vector(dimension);
+  for (size_t i = 0; i < population_size; i++) {
+        workspace->population[i] = coco_allocate_vector(stored);
+        workspace->trial[i] = coco_allocate_vector(dimension);
+        workspace->tmp[i] = coco_allocate_vector(dimension);
+        workspace->changed[i] = (size_t*)malloc(dimension * sizeof(size_t));
+        if (!workspace->changed[i]) {
+            fprintf(stderr, "Memory allocation failed for de_workspace.\n");
+            exit(EXIT_FAILURE);
+        }
+  }
+  for (size_t j = 0; j < dimension; j++) {
+    if(variant->encoding == 0){
+      workspace->repair_lower[j] = lower_bounds[j];
+      workspace->repair_upper[j] = upper_bounds[j];
+    }
+    else if(variant->encoding == 1){
+      workspace->repair_lower[j] = 0;
+      workspace->repair_upper[j] = 1;
+    }
+    else if(variant->encoding == 2){
+      workspace->repair_lower[j] = lower_bounds[j] - 0.5;
+      workspace->repair_upper[j] = upper_bounds[j] + 0.5 - FLT_EPSILON;
+    }
+  }
+  workspace->number_of_codes = number_of_codes;
+  workspace->codes = NULL;
+  workspace->decode = NULL;
+  workspace->number_of_values = NULL;
+  workspace->code_values = NULL;
+  if(number_of_codes > 0){
+    size_t tables = 0;
+    for (size_t j = 0; j < number_of_codes; j++) {
+      size_t same = 0;
+      while(same < j && upper_bounds[same] != upper_bounds[j]){
+        same++;
+      }
+      tables += same == j;
+    }
+    workspace->codes = (unsigned char**)malloc(population_size * sizeof(unsigned char*));
+    workspace->decode = (const double**)malloc(number_of_codes * sizeof(double*));
+    workspace->number_of_values = (size_t*)malloc(number_of_codes * sizeof(size_t));
+    workspace->code_values = (double*)malloc(tables * DE_MAX_CODES * sizeof(double));
+    if (!workspace->codes || !workspace->decode || !workspace->number_of_values || !workspace->code_values) {
+      fprintf(stderr, "Memory allocation failed for de_workspace.\n");
+      exit(EXIT_FAILURE);
+    }
+    workspace->codes[0] = (unsigned char*)malloc(population_size * number_of_codes);
+    if (!workspace->codes[0]) {
+      fprintf(stderr, "Memory allocation failed for de_workspace.\n");
+      exit(EXIT_FAILURE);
+    }
+    for (size_t i = 1; i < population_size; i++) {
+      workspace->codes[i] = workspace->codes[0] + i * number_of_codes;
+    }
+    //one table per distinct upper bound
+    tables = 0;
+    for (size_t j = 0; j < number_of_codes; j++) {
+      size_t same = 0;
+      while(same < j && upper_bounds[same] != upper_bounds[j]){
+        same++;
+      }
+      if(same < j){
+        workspace->decode[j] = workspace->decode[same];
+        workspace->number_of_values[j] = workspace->number_of_values[same];
+        continue;
+      }
+      double *values = workspace->code_values + tables++ * DE_MAX_CODES;
+      if(3 * upper_bounds[j] + 6 > DE_MAX_CODES){
+        fprintf(stderr, "Integer variable %lu has too many values for the compact population.\n", (unsigned long)j);
+        exit(EXIT_FAILURE);
+      }
+      workspace->decode[j] = values;
+      workspace->number_of_values[j] = de_code_values(values, upper_bounds[j], variant->encoding);
+    }
+  }
+  return workspace;
+}
+
+void de_workspace_free(de_workspace_t *workspace){
+  for (size_t i = 0; i < workspace->population_size; ++i) {
+    coco_free_memory(workspace->population[i]);
+    coco_free_memory(workspace->trial[i]);
+    coco_free_memory(workspace->tmp[i]);
+    free(workspace->changed[i]);
+  }
+  free(workspace->population);
+  free(workspace->trial);
+  free(workspace->tmp);
+  free(workspace->changed);
+  free(workspace->number_of_changed);
+  if(workspace->codes != NULL){
+    free(workspace->codes[0]);
+  }
+  free(workspace->codes);
+  free(workspace->decode);
+  free(workspace->number_of_values);
+  free(workspace->code_values);
+  coco_free_memory(workspace->mutate);
+  coco_free_memory(workspace->rnd_vals);
+  coco_free_memory(workspace->repair_lower);
+  coco_free_memory(workspace->repair_upper);
+  coco_free_memory(workspace->parent);
+  coco_free_memory(workspace);
+}
+
+/**
+ * Stores the encoded point x as individual i of the population, its integer block as the codes of
+ * its values if the workspace has codes. The values are looked up exactly, so
+ * de_population_load gives back x bit for bit.
+ */
+void de_population_store(de_workspace_t *workspace, size_t i, const double *x, size_t dimension){
+  const size_t k = workspace->number_of_codes;
+
+  for(size_t j = 0; j < k; j++){
+    const double *decode = workspace->decode[j];
+    size_t low = 0, high = workspace->number_of_values[j];
+    while(low < high){
+      size_t middle = (low + high) / 2;
+      if(decode[middle] < x[j]){
+        low = middle + 1;
+      }
+      else{
+        high = middle;
+      }
+    }
+    if(low == workspace->number_of_values[j] || decode[low] != x[j]){
+      fprintf(stderr, "Integer variable %lu has the value %.17g, which is not one of the encoding.\n", (unsigned long)j, x[j]);
+      exit(EXIT_FAILURE);
+    }
+    workspace->codes[i][j] = (unsigned char)low;
+  }
+  for(size_t j = k; j < dimension; j++){
+    workspace->population[i][j - k] = x[j];
+  }
+}
+
+/**
+ * Writes individual i of the population to x.
+ */
+void de_population_load(const de_workspace_t *workspace, size_t i, double *x, size_t dimension){
+  const size_t k = workspace->number_of_codes;
+
+  for(size_t j = 0; j < k; j++){
+    x[j] = workspace->decode[j][workspace->codes[i][j]];
+  }
+  for(size_t j = k; j < dimension; j++){
+    x[j] = workspace->population[i][j - k];
+  }
+}
+
+void round_vec(double *x, size_t number_of_integer_variables, const double *upper_bounds){
+  round_vec_impl(x, number_of_integer_variables, upper_bounds);
+}
+
+void new_round_vec(double *x, size_t number_of_integer_variables, const double *upper_bounds, int approach){
+  new_round_vec_impl(x, number_of_integer_variables, upper_bounds, approach);
+}
+
+void decoding_vec(double *x, size_t dimention_size, size_t number_of_integer_variables, const double *upper_bounds){
+  decoding_vec_impl(x, dimention_size, number_of_integer_variables, upper_bounds);
+}
+
+/**
+ * Adds point i (0-based) of a population to the running means and sums of squared deviations of
+ * its coordinates (Welford). The points are visited one row at a time, so the loop runs over
+ * contiguous memory and is vectorized.
+ */
+static FORCE_INLINE void population_moments_add(double *mean, double *m2, const double *x, size_t i, size_t dimension){
+  const double weight = 1.0 / (double)(i + 1);
+  for(size_t j = 0; j < dimension; j++){
+    double delta = x[j] - mean[j];
+    mean[j] += delta * weight;
+    m2[j] += delta * (x[j] - mean[j]);
+  }
+}
+
+/**
+ * Mean (in sum) and standard deviation (in sum2) of every coordinate of the population tmp,
+ * computed in one pass.
+ */
+void ea_sd_calc(double* sum, double* sum2, double** tmp, size_t number_of_points, size_t dimension){
+  for(size_t j = 0; j < dimension; j++){
+    sum[j] = 0;
+    sum2[j] = 0;
+  }
+  for(size_t i = 0; i < number_of_points; i++){
+    population_moments_add(sum, sum2, tmp[i], i, dimension);
+  }
+  //hyoujyunhensa
+  for(size_t j = 0; j < dimension; j++){
+    sum2[j] = sqrt(sum2[j]/(double)number_of_points);
+  }
+}
+
+population_stats_t *population_stats_new(size_t dimension, size_t number_of_integer_variables, const double *lower_bounds, const double *upper_bounds){
+  population_stats_t *stats = (population_stats_t *)coco_allocate_memory(sizeof(*stats));
+  stats->dimension = dimension;
+  stats->number_of_integer_variables = number_of_integer_variables;
+  stats->number_of_points = 0;
+  stats->lower_bounds = lower_bounds;
+  stats->upper_bounds = upper_bounds;
+  stats->mean = coco_allocate_vector(dimension);
+  stats->m2 = coco_allocate_vector(dimension);
+  stats->min = coco_allocate_vector(dimension);
+  stats->max = coco_allocate_vector(dimension);
+  stats->stride = 1;
+  for(size_t j = 0; j < number_of_integer_variables; j++){
+    size_t bins = (size_t)(upper_bounds[j] - lower_bounds[j]) + 1;
+    stats->stride = bins > stats->stride ? bins : stats->stride;
+  }
+  stats->histogram = (size_t *)malloc((number_of_integer_variables * stats->stride + 1) * sizeof(size_t));
+  if(stats->histogram == NULL){
+    fprintf(stderr, "Memory allocation failed for population_stats.\n");
+    exit(EXIT_FAILURE);
+  }
+  return stats;
+}
+
+void population_stats_free(population_stats_t *stats){
+  coco_free_memory(stats->mean);
+  coco_free_memory(stats->m2);
+  coco_free_memory(stats->min);
+  coco_free_memory(stats->max);
+  free(stats->histogram);
+  coco_free_memory(stats);
+}
+
+/**
+ * Computes mean, variance, min and max of every coordinate and the histograms of the integer
+ * coordinates of the encoded points x in one pass over the points.
+ */
+void population_stats_compute(population_stats_t *stats, double **x, size_t number_of_points){
+  const size_t dimension = stats->dimension;
+  const size_t number_of_integer_variables = stats->number_of_integer_variables;
+  const size_t stride = stats->stride;
+  double *mean = stats->mean;
+  double *m2 = stats->m2;
+  double *min = stats->min;
+  double *max = stats->max;
+  size_t *histogram = stats->histogram;
+
+  for(size_t j = 0; j < dimension; j++){
+    mean[j] = 0;
+    m2[j] = 0;
+    min[j] = HUGE_VAL;
+    max[j] = -HUGE_VAL;
+  }
+  memset(histogram, 0, number_of_integer_variables * stride * sizeof(size_t));
+  for(size_t i = 0; i < number_of_points; i++){
+    const double *xi = x[i];
+    population_moments_add(mean, m2, xi, i, dimension);
+    for(size_t j = 0; j < dimension; j++){
+      min[j] = xi[j] < min[j] ? xi[j] : min[j];
+      max[j] = xi[j] > max[j] ? xi[j] : max[j];
+    }
+    for(size_t j = 0; j < number_of_integer_variables; j++){
+      double v = xi[j] - stats->lower_bounds[j];
+      size_t bin = v <= 0 ? 0 : (size_t)v;
+      histogram[j * stride + (bin < stride ? bin : stride - 1)]++;
+    }
+  }
+  stats->number_of_points = number_of_points;
+}
+
+/**
+ * Returns 1 if the population has converged: every integer coordinate takes a single value and
+ * the standard deviation of every continuous coordinate is at most threshold times its range.
+ */
+int population_stats_converged(const population_stats_t *stats, double threshold){
+  const size_t stride = stats->stride;
+
+  for(size_t j = 0; j < stats->number_of_integer_variables; j++){
+    size_t largest = 0;
+    for(size_t v = 0; v < stride; v++){
+      largest = stats->histogram[j * stride + v] > largest ? stats->histogram[j * stride + v] : largest;
+    }
+    if(largest != stats->number_of_points){
+      return 0;
+    }
+  }
+  for(size_t j = stats->number_of_integer_variables; j < stats->dimension; j++){
+    double range = stats->upper_bounds[j] - stats->lower_bounds[j];
+    if(stats->m2[j] > threshold * threshold * range * range * (double)stats->number_of_points){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+//ND_ARCHIVE
+nd_archive_t *nd_archive_new(void){
+  nd_archive_t *archive = (nd_archive_t *)coco_allocate_memory(sizeof(nd_archive_t));
+  archive->size = 0;
+  archive->capacity = 4 * DE_N;
+  archive->front = coco_allocate_vector(2 * archive->capacity);
+  return archive;
+}
+
+void nd_archive_free(nd_archive_t *archive){
+  coco_free_memory(archive->front);
+  coco_free_memory(archive);
+}
+
+/**
+ * Returns the number of points of the front whose f1 is at most f1 (bound 0) or less than f1
+ * (bound 1).
+ */
+static size_t nd_archive_search(const nd_archive_t *archive, double f1, int strict){
+  size_t low = 0, high = archive->size;
+  while(low < high){
+    size_t middle = low + (high - low) / 2;
+    double v = archive->front[2 * middle];
+    if(strict ? v < f1 : v <= f1){
+      low = middle + 1;
+    }
+    else{
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/**
+ * Returns 1 if a point of the archive weakly dominates (f1, f2). Of the points whose f1 is at most
+ * f1, the last one has the smallest f2, so it is the only one to compare with.
+ */
+int nd_archive_dominated(const nd_archive_t *archive, double f1, double f2){
+  size_t upper = nd_archive_search(archive, f1, 0);
+  return upper > 0 && archive->front[2 * (upper - 1) + 1] <= f2;
+}
+
+/**
+ * Inserts (f1, f2), which no point of the archive weakly dominates, and removes the points it
+ * dominates. These have f1 at least f1 and f2 at least f2, so they are the run of the front that
+ * starts at the insertion position and ends at the first point with a smaller f2.
+ */
+void nd_archive_insert(nd_archive_t *archive, double f1, double f2){
+  size_t lower = nd_archive_search(archive, f1, 1);
+  size_t low = lower, high = archive->size;
+  size_t removed;
+
+  while(low < high){
+    size_t middle = low + (high - low) / 2;
+    if(archive->front[2 * middle + 1] >= f2){
+      low = middle + 1;
+    }
+    else{
+      high = middle;
+    }
+  }
+  removed = low - lower;
+  if(removed == 0 && archive->size == archive->capacity){
+    double *front = coco_allocate_vector(4 * archive->capacity);
+    memcpy(front, archive->front, 2 * archive->size * sizeof(double));
+    coco_free_memory(archive->front);
+    archive->front = front;
+    archive->capacity *= 2;
+  }
+  if(removed != 1){
+    memmove(archive->front + 2 * (lower + 1), archive->front + 2 * low, 2 * (archive->size - low) * sizeof(double));
+  }
+  archive->front[2 * lower] = f1;
+  archive->front[2 * lower + 1] = f2;
+  archive->size = archive->size + 1 - removed;
+}
+
+static int compare_nd_candidate(const void *a, const void *b){
+  const nd_candidate_t *ca = (const nd_candidate_t *)a;
+  const nd_candidate_t *cb = (const nd_candidate_t *)b;
+  if(ca->f1 != cb->f1){
+    return ca->f1 < cb->f1 ? -1 : 1;
+  }
+  if(ca->f2 != cb->f2){
+    return ca->f2 < cb->f2 ? -1 : 1;
+  }
+  return ca->index < cb->index ? -1 : (ca->index > cb->index ? 1 : 0);
+}
+
+/**
+ * Inserts the points values[0..number_of_points-1] of a generation (at most DE_N) into the archive
+ * and sets entered[i] to 1 if point i entered it. The batch is sorted first, so the points
+ * dominated within the batch are dropped in one pass and only the others are looked up in the
+ * archive. Of several equal points, the first one enters. Returns the number of points that
+ * entered.
+ */
+size_t nd_archive_insert_batch(nd_archive_t *archive, double (*values)[2], size_t number_of_points, int *entered){
+  nd_candidate_t *candidates = archive->candidates;
+  double best_f2 = HUGE_VAL;
+  size_t number_of_entered = 0;
+
+  for(size_t i = 0; i < number_of_points; i++){
+    candidates[i].f1 = values[i][0];
+    candidates[i].f2 = values[i][1];
+    candidates[i].index = i;
+    entered[i] = 0;
+  }
+  qsort(candidates, number_of_points, sizeof(nd_candidate_t), compare_nd_candidate);
+  for(size_t k = 0; k < number_of_points; k++){
+    //a candidate is dominated within the batch unless its f2 is below the ones of all candidates before it
+    if(candidates[k].f2 >= best_f2){
+      continue;
+    }
+    best_f2 = candidates[k].f2;
+    if(!nd_archive_dominated(archive, candidates[k].f1, candidates[k].f2)){
+      nd_archive_insert(archive, candidates[k].f1, candidates[k].f2);
+      entered[candidates[k].index] = 1;
+      number_of_entered++;
+    }
+  }
+  return number_of_entered;
+}
+
+//COCO
+/**
+ * Allocates memory for the timing_data_t object and initializes it.
+ */
+static timing_data_t *timing_data_initialize(coco_suite_t *suite) {
+
+	timing_data_t *timing_data = (timing_data_t *) coco_allocate_memory(sizeof(*timing_data));
+	size_t function_idx, dimension_idx, instance_idx, i;
+
+	/* Find out the number of all dimensions */
+	coco_suite_decode_problem_index(suite, coco_suite_get_number_of_problems(suite) - 1, &function_idx,
+			&dimension_idx, &instance_idx);
+	timing_data->number_of_dimensions = dimension_idx + 1;
+	timing_data->current_idx = 0;
+	timing_data->output = (char **) coco_allocate_memory(timing_data->number_of_dimensions * sizeof(char *));
+	for (i = 0; i < timing_data->number_of_dimensions; i++) {
+		timing_data->output[i] = NULL;
+	}
+	timing_data->previous_dimension = 0;
+	timing_data->cumulative_evaluations = 0;
+	time(&timing_data->start_time);
+	time(&timing_data->overall_start_time);
+
+	return timing_data;
+}
+
+/**
+ * Keeps track of the total number of evaluations and elapsed time. Produces an output string when the
+ * current problem is of a different dimension than the previous one or when NULL.
+ */
+static void timing_data_time_problem(timing_data_t *timing_data, coco_problem_t *problem) {
+
+	double elapsed_seconds = 0;
+
+	if ((problem == NULL) || (timing_data->previous_dimension != coco_problem_get_dimension(problem))) {
+
+		/* Output existing timing information */
+		if (timing_data->cumulative_evaluations > 0) {
+			time_t now;
+			time(&now);
+			elapsed_seconds = difftime(now, timing_data->start_time) / (double) timing_data->cumulative_evaluations;
+			timing_data->output[timing_data->current_idx++] = coco_strdupf("d=%lu done in %.2e seconds/evaluation\n",
+					timing_data->previous_dimension, elapsed_seconds);
+		}
+
+		if (problem != NULL) {
+			/* Re-initialize the timing_data */
+			timing_data->previous_dimension = coco_problem_get_dimension(problem);
+			timing_data->cumulative_evaluations = coco_problem_get_evaluations(problem);
+			time(&timing_data->start_time);
+		}
+
+	} else {
+		timing_data->cumulative_evaluations += coco_problem_get_evaluations(problem);
+	}
+}
+
+/**
+ * Outputs and finalizes the given timing data.
+ */
+static void timing_data_finalize(timing_data_t *timing_data) {
+
+	/* Record the last problem */
+	timing_data_time_problem(timing_data, NULL);
+
+  if (timing_data) {
+  	size_t i;
+  	double elapsed_seconds;
+		time_t now;
+		int hours, minutes, seconds;
+
+		time(&now);
+		elapsed_seconds = difftime(now, timing_data->overall_start_time);
+
+  	printf("\n");
+  	for (i = 0; i < timing_data->number_of_dimensions; i++) {
+    	if (timing_data->output[i]) {
+				printf("%s", timing_data->output[i]);
+				coco_free_memory(timing_data->output[i]);
+    	}
+    }
+  	hours = (int) elapsed_seconds / 3600;
+  	minutes = ((int) elapsed_seconds % 3600) / 60;
+  	seconds = (int)elapsed_seconds - (hours * 3600) - (minutes * 60);
+  	printf("Total elapsed time: %dh%02dm%02ds\n", hours, minutes, seconds);
+
+    coco_free_memory(timing_data->output);
+    coco_free_memory(timing_data);
+  }
+}
+
+// the function is able to get coco-function number
+char *get_short_function_number(const char *problem_name) {
+    const char *f_position = strstr(problem_name, "f");
+    if (f_position == NULL) {
+        return NULL;  // "f"が見つからない場合はNULLを返す
+    }
+
+    int number = atoi(f_position + 1); // "f"の後ろから整数部分を取得
+    char *short_name = (char *)malloc(10 * sizeof(char));
+    if (short_name == NULL) {
+        return NULL;  // メモリ割り当てに失敗した場合はNULLを返す
+    }
+
+    sprintf(short_name, "f%d", number); // 短縮形式の"f1"や"f2"を生成
+    return short_name;
+}
+
+//EA algorithm
+void de_nopcm(evaluate_function_t evaluate_func,
+                      coco_problem_t *problem,
+                      const size_t dimension,
+                      const size_t number_of_objectives,
+                      const size_t number_of_integer_variables,
+                      const double *lower_bounds,
+                      const double *upper_bounds,
+                      const size_t max_budget,
+                      const de_variant_t *variant,
+                      coco_random_state_t *random_generator,
+                      char *titlestr){
+  de_workspace_t *workspace = de_workspace_new(dimension, 0, lower_bounds, upper_bounds, variant);
+  const de_kernels_t *kernels = de_select_kernels(variant, dimension);
+  double **population = workspace->population;
+  double **trial = workspace->trial;
+  double **tmp = workspace->tmp;
+  double functions_values[2];
+  size_t evaluation = 0;
+  size_t i, j;
+  double value_population[DE_N];
+  double value_trial[DE_N];
+  double objectives_population[DE_N][2];
+  double objectives_trial[DE_N][2];
+  int entered[DE_N];
+  double *sum = coco_allocate_vector(dimension); 
+  double *sum2 = coco_allocate_vector(dimension); 
+  int output_cnt = 0;
+  population_stats_t *stats = NULL;
+  nd_archive_t *archive = NULL;
+  if(DE_RESTART_DIVERSITY > 0){
+    stats = population_stats_new(dimension, number_of_integer_variables, lower_bounds, upper_bounds);
+  }
+  if(number_of_objectives > 2){
+    fprintf(stderr, "The DE supports at most 2 objectives, %s has %lu.\n", coco_problem_get_name(problem), (unsigned long)number_of_objectives);
+    exit(EXIT_FAILURE);
+  }
+  if(number_of_objectives == 2){
+    archive = nd_archive_new();
+  }
+
+  //initialization
+  variant->initialization(population, DE_N, dimension, number_of_integer_variables, lower_bounds, upper_bounds, random_generator);
+  //encoding
+  kernels->encoding_step(population, tmp, DE_N, dimension, number_of_integer_variables, upper_bounds);
+  //evaluation
+  for (i = 0; i < DE_N; i++) {
+    evaluate_func(problem, tmp[i], functions_values);
+    evaluation++;
+    value_population[i] = functions_values[0];
+    if(archive != NULL){
+      objectives_population[i][0] = functions_values[0];
+      objectives_population[i][1] = functions_values[1];
+    }
+  }
+  if(archive != NULL){
+    nd_archive_insert_batch(archive, objectives_population, DE_N, entered);
+  }
+  ALLOC_PHASE(ALLOC_PHASE_GENERATIONS);
+  //hanpuku
+  while(evaluation  < max_budget){
+    //hyoujyunhensa+output
+    if(output_cnt == 0 && trajectory_logger != NULL){
+      double best_value = value_population[0];
+      for(i = 1; i < DE_N; i++){
+        best_value = value_population[i] < best_value ? value_population[i] : best_value;
+      }
+      ea_sd_calc(sum, sum2, tmp, DE_N, dimension);
+      trajectory_sample((double)coco_problem_get_evaluations(problem), best_value, sum2, dimension);
+    }
+    //restart once the population has converged
+    if(stats != NULL){
+      population_stats_compute(stats, tmp, DE_N);
+      if(population_stats_converged(stats, DE_RESTART_DIVERSITY)){
+        break;
+      }
+    }
+    output_cnt++;
+    if(output_cnt == dimension){
+      output_cnt = 0;
+    }
+
+    //mutation, crossover and encoding
+    kernels->generation(workspace, dimension, number_of_integer_variables, upper_bounds, random_generator);
+    //evaluation
+    for (i = 0; i < DE_N; i++) {
+      evaluate_func(problem, tmp[i], functions_values);
+      evaluation++;
+      value_trial[i] = functions_values[0];
+      if(archive != NULL){
+        objectives_trial[i][0] = functions_values[0];
+        objectives_trial[i][1] = functions_values[1];
+      }
+    }
+
+    //enviroment selection
+    if(archive != NULL){
+      //a trial replaces its parent if it weakly dominates it, or if they are incomparable and the trial entered the archive
+      nd_archive_insert_batch(archive, objectives_trial, DE_N, entered);
+      for(i = 0; i < DE_N; i++){
+        int trial_better = objectives_trial[i][0] <= objectives_population[i][0] && objectives_trial[i][1] <= objectives_population[i][1];
+        int parent_better = objectives_population[i][0] <= objectives_trial[i][0] && objectives_population[i][1] <= objectives_trial[i][1];
+        if(trial_better || (!parent_better && entered[i])){
+          for (j = 0; j < dimension; j++) {
+            population[i][j] = trial[i][j];
+          }
+          value_population[i] = value_trial[i];
+          objectives_population[i][0] = objectives_trial[i][0];
+          objectives_population[i][1] = objectives_trial[i][1];
+        }
+      }
+    }
+    else{
+      for(i = 0; i < DE_N; i++){
+        if(value_trial[i] <= value_population[i]){
+          for (j = 0; j < dimension; j++) {
+            population[i][j] = trial[i][j];
+          }
+          value_population[i] = value_trial[i];
+        }
+      }
+    }
+  }
+  ALLOC_PHASE(ALLOC_PHASE_SETUP);
+  //next instance
+  instance_cnt++;
+  if(instance_cnt == 15){
+    instance_cnt = 0;
+  }
+  //memory free
+  de_workspace_free(workspace);
+  if(stats != NULL){
+    population_stats_free(stats);
+  }
+  if(archive != NULL){
+    nd_archive_free(archive);
+  }
+  coco_free_memory(sum);
+  coco_free_memory(sum2);
+}
+
+int find_min_index(const double value_population[], size_t population_size) {
+  int min_index = 0;  // 最初の要素を最小値と仮定
+  for (int i = 1; i < population_size; i++) {
+      if (value_population[i] < value_population[min_index]) {
+          min_index = i;  // 最小値を更新
+      }
+  }
+  return min_index;
+}
+
+/**
+ * Starts a DE run on the problem within max_budget evaluations: draws and encodes the initial
+ * population, whose values the run asks for first.
+ */
+de_run_t *de_run_new(MY_PROBLEM *problem,
+                     const size_t max_budget,
+                     const de_variant_t *variant,
+                     coco_random_state_t *random_generator){
+  const size_t dimension = problem->dimension;
+  const size_t number_of_integer_variables = problem->number_of_integer_variables;
+  de_run_t *run = (de_run_t *)coco_allocate_memory(sizeof(de_run_t));
+
+  run->problem = problem;
+  run->variant = variant;
+  run->kernels = de_select_kernels(variant, dimension);
+  run->random_generator = random_generator;
+  run->workspace = de_workspace_new(dimension, DE_COMPACT_POPULATION && DE_LAMARCKIAN(variant->encoding, variant->approach) ? number_of_integer_variables : 0,
+                                    problem->smallest, problem->largest, variant);
+  run->delta = de_delta_new(problem, variant);
+  run->sum = coco_allocate_vector(dimension);
+  run->sum2 = coco_allocate_vector(dimension);
+  run->stats = NULL;
+  if(DE_RESTART_DIVERSITY > 0){
+    run->stats = population_stats_new(dimension, number_of_integer_variables, problem->smallest, problem->largest);
+  }
+  run->max_budget = max_budget;
+  run->evaluation = 0;
+  run->output_cnt = 0;
+  run->min_pos = 0;
+  run->trace = NULL;
+  run->value_population = coco_allocate_vector(variant->population_size);
+  run->value_trial = coco_allocate_vector(variant->population_size);
+  //initialization, drawn as trials and stored once encoded
+  variant->initialization(run->workspace->trial, variant->population_size, dimension, number_of_integer_variables, problem->smallest, problem->largest, random_generator);
+  //encoding
+  run->kernels->encoding_step(run->workspace->trial, run->workspace->tmp, variant->population_size, dimension, number_of_integer_variables, problem->largest);
+  for(size_t i = 0; i < variant->population_size; i++){
+    de_population_store(run->workspace, i, run->workspace->trial[i], dimension);
+  }
+  run->state = DE_RUN_POPULATION;
+  run->values = run->value_population;
+  return run;
+}
+
+/**
+ * Returns the encoded points, as many as the population size of the variant, whose values the run asks for, to be written to run->values
+ * (by de_run_evaluate or by the caller) before de_run_tell, or NULL once the run is done. After the
+ * initial population, asking ends the run if the budget is exhausted, the final target was hit or
+ * the population has converged, and otherwise produces the trials of the next generation, so it
+ * must be called once per tell.
+ */
+double **de_run_ask(de_run_t *run){
+  MY_PROBLEM *problem = run->problem;
+  const size_t dimension = problem->dimension;
+
+  if(run->state == DE_RUN_TRIALS){
+    if(run->evaluation >= run->max_budget || problem->end_flag == 1){
+      run->state = DE_RUN_DONE;
+    }
+  }
+  if(run->state == DE_RUN_DONE){
+    return NULL;
+  }
+  if(run->state == DE_RUN_POPULATION){
+    return run->workspace->tmp;
+  }
+  //hyoujyunhensa+output
+  if(run->output_cnt == 0 && trajectory_logger != NULL){
+    ea_sd_calc(run->sum, run->sum2, run->workspace->tmp, run->workspace->population_size, dimension);
+    trajectory_sample((double)(problem->evaluation_cnt + run->evaluation), run->value_population[run->min_pos], run->sum2, dimension);
+  }
+  //restart once the population has converged
+  if(run->stats != NULL){
+    population_stats_compute(run->stats, run->workspace->tmp, run->workspace->population_size);
+    if(population_stats_converged(run->stats, DE_RESTART_DIVERSITY)){
+      run->state = DE_RUN_DONE;
+      return NULL;
+    }
+  }
+  run->output_cnt++;
+  if(run->output_cnt == dimension){
+    run->output_cnt = 0;
+  }
+
+  //mutation, crossover and encoding
+  run->kernels->generation(run->workspace, dimension, problem->number_of_integer_variables, problem->largest, run->random_generator);
+  return run->workspace->tmp;
+}
+
+/**
+ * Evaluates the points x asked by the run on its problem into run->values, incrementally if the
+ * run has a delta state.
+ */
+void de_run_evaluate(de_run_t *run, double **x){
+  if(run->delta != NULL && run->state == DE_RUN_POPULATION){
+    de_delta_evaluate_population(run->delta, run->problem, x, run->values);
+  }
+  else if(run->delta != NULL){
+    de_delta_evaluate_trials(run->delta, run->problem, run->workspace, x, run->values);
+  }
+  else{
+    my_evaluate_population(run->problem, x, run->workspace->population_size, run->values);
+  }
+}
+
+/**
+ * Takes the values of the asked points: samples the encoded points for the trace, keeps the
+ * trials that are at least as good as their individuals, then records the targets the best
+ * individual hits.
+ */
+void de_run_tell(de_run_t *run){
+  MY_PROBLEM *problem = run->problem;
+  double **trial = run->workspace->trial;
+  const size_t population_size = run->workspace->population_size;
+  size_t i;
+
+  if(run->trace != NULL){
+    trace_sample(run->trace, trial, run->values, (double)(problem->evaluation_cnt + run->evaluation));
+  }
+  run->evaluation += (int)population_size;
+  if(run->state == DE_RUN_TRIALS){
+    //enviroment selection
+    for(i = 0; i < population_size; i++){
+      if(run->value_trial[i] <= run->value_population[i]){
+        de_population_store(run->workspace, i, trial[i], problem->dimension);
+        run->value_population[i] = run->value_trial[i];
+        if(run->delta != NULL){
+          de_delta_accept(run->delta, i);
+        }
+      }
+    }
+  }
+  run->state = DE_RUN_TRIALS;
+  run->values = run->value_trial;
+
+  run->min_pos =  find_min_index(run->value_population, population_size);
+  for(size_t target_cnt = 0; target_cnt < NUMBER_OF_TARGET; target_cnt++){
+    if(target[target_cnt] > run->value_population[run->min_pos]){
+      if(problem->evaluate_result[target_cnt] == -1){
+        problem->evaluate_result[target_cnt] = run->evaluation;
+      }
+      else if(problem->evaluate_result[target_cnt] > run->evaluation){
+        problem->evaluate_result[target_cnt] = run->evaluation;
+      }
+      if(problem->first_hit[target_cnt] == -1){
+        problem->first_hit[target_cnt] = problem->evaluation_cnt + run->evaluation;
+      }
+      if(target_cnt == NUMBER_OF_TARGET - 1){
+        problem->end_flag = 1;
+      }
+    }
+  }
+}
+
+/**
+ * Ends the run: the best individual replaces the best solution of the problem if it is better, and
+ * the evaluations of the run are added to the ones of the problem.
+ */
+void de_run_free(de_run_t *run){
+  MY_PROBLEM *problem = run->problem;
+  double *best = run->workspace->parent;
+
+  de_population_load(run->workspace, (size_t)run->min_pos, best, problem->dimension);
+  if(my_evaluate_point(problem, problem->best_solution) > my_evaluate_point(problem, best)){
+    for(size_t i = 0; i < problem->dimension; i++){
+      problem->best_solution[i] = best[i];
+    }
+  }
+
+  problem->end_flag = 0;
+  problem->evaluation_cnt += run->evaluation;
+  //memory free
+  de_workspace_free(run->workspace);
+  if(run->stats != NULL){
+    population_stats_free(run->stats);
+  }
+  if(run->delta != NULL){
+    de_delta_free(run->delta);
+  }
+  coco_free_memory(run->sum);
+  coco_free_memory(run->sum2);
+  coco_free_memory(run->value_population);
+  coco_free_memory(run->value_trial);
+  coco_free_memory(run);
+}
+
+//MY_EVALUATE_FUNC
+// void f1(const double *x, double *y, size_t dimension, double* optimal) {//sphere
+//   y[0] = 0;
+//   for(size_t i = 0; i < dimension; i++){
+//     y[0] += (optimal[i] - x[i])*(optimal[i] - x[i]);
+//   }
+// }
+
+// void f2(const double *x, double *y, size_t dimension, double* optimal) {//sphere
+//   y[0] = 0;
+//   for(size_t i = 0; i < dimension; i++){
+//     y[0] += pow(10, 6*i/(dimension - 1)) * (optimal[i] - x[i])*(optimal[i] - x[i]);
+//   }
+
+//   y[0] = pow(10, -3) * y[0];
+// }
+
+// void f3(const double *x, double *y, size_t dimension, double* optimal) {//rastrigin
+//   y[0] = 0;
+//   for(size_t i = 0; i < dimension; i++){
+//     y[0] += (optimal[i] - x[i])*(optimal[i] - x[i]) - 10*cos(2*M_PI*(optimal[i] - x[i]));
+//   }
+
+//   y[0] += 10*(double)dimension;
+
+//   y[0] = 0.1 * y[0];
+// }
+
+// void f8(const double *x, double *y, size_t dimension, double* optimal) {//rosenbrock
+//   y[0] = 0;
+//   for(size_t i = 0; i < dimension - 1; i++){
+//     y[0] += 100*((optimal[i + 1] - x[i + 1]) - (optimal[i] - x[i]) * (optimal[i] - x[i]))*((optimal[i + 1] - x[i + 1]) - (optimal[i] - x[i]) * (optimal[i] - x[i])) + (optimal[i] - x[i] - 1)*(optimal[i] - x[i] - 1);
+//   }
+// }
+
+/*
+ * The separable functions are written as sums of per-coordinate terms (the *_term functions), so
+ * that the contribution of an integer coordinate can be looked up in an integer_table_t built from
+ * the same terms. The table-driven variants (*_table) sum the table entries of the integer block
+ * and the terms of the continuous block in coordinate order, which gives the same value as the
+ * arithmetic variant for encoded points.
+ */
+static FORCE_INLINE double f_sphere_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  (void)i;
+  (void)number_of_variables;
+  return shifted_x * shifted_x;
+}
+
+static FORCE_INLINE double f_sphere_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i = 0;
+  double result = 0.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    result += f_sphere_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+
+  return result;
+}
+
+static FORCE_INLINE double f_ellipsoid_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  static const double condition = 1.0e6;
+  double exponent;
+
+  if (i == 0) {
+    return shifted_x * shifted_x;
+  }
+  exponent = 1.0 * (double)(long)i / ((double)(long)number_of_variables - 1.0);
+  return pow(condition, exponent) * shifted_x * shifted_x;
+}
+
+static FORCE_INLINE double f_ellipsoid_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i = 0;
+  double result = 0.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    result += f_ellipsoid_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+
+  return result;
+}
+
+static FORCE_INLINE double f_rastrigin_raw_cos_term(double shifted_x, size_t i, size_t number_of_variables) {
+  (void)i;
+  (void)number_of_variables;
+  return cos(coco_two_pi * shifted_x);
+}
+
+static FORCE_INLINE double f_rastrigin_raw_finalize(double sum1, double sum2, size_t number_of_variables) {
+  if (sum2 > 1e22) /* cos(inf) -> nan */
+    return sum2;
+
+  return 10.0 * ((double)(long)number_of_variables - sum1) + sum2;
+}
+
+static FORCE_INLINE double f_rastrigin_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i = 0;
+  double sum1 = 0.0, sum2 = 0.0;
+  double shifted_x;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    shifted_x = x[i] - opt[i];
+    sum1 += f_rastrigin_raw_cos_term(shifted_x, i, number_of_variables);
+    sum2 += f_sphere_raw_term(shifted_x, i, number_of_variables);
+  }
+
+  return f_rastrigin_raw_finalize(sum1, sum2, number_of_variables);
+}
+
+/* Terms of the pair (x[i], x[i + 1]), which is what makes rosenbrock a chain kernel. */
+static FORCE_INLINE void f_rosenbrock_raw_delta_terms(const double *x, const double *opt, size_t i, size_t number_of_variables, double *t) {
+  double tmp;
+
+  (void)number_of_variables;
+  tmp = ((x[i] - opt[i]) * (x[i] - opt[i]) - (x[i + 1] - opt[i + 1]));
+  t[0] = tmp * tmp;
+  tmp = (x[i] - opt[i] - 1.0);
+  t[1] = tmp * tmp;
+}
+
+static double f_rosenbrock_raw_delta_finalize(const double *sums, size_t number_of_variables) {
+  (void)number_of_variables;
+  return 100.0 * sums[0] + sums[1];
+}
+
+static FORCE_INLINE double f_rosenbrock_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i = 0;
+  double sums[2] = {0.0, 0.0};
+  double t[2];
+
+  for (i = 0; i < number_of_variables - 1; ++i) {
+    f_rosenbrock_raw_delta_terms(x, opt, i, number_of_variables, t);
+    sums[0] += t[0];
+    sums[1] += t[1];
+  }
+
+  return f_rosenbrock_raw_delta_finalize(sums, number_of_variables);
+}
+static const delta_kernel_t f_rosenbrock_raw_delta = {2, 1, f_rosenbrock_raw_delta_terms};
+
+static FORCE_INLINE double f_bent_cigar_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  static const double condition = 1.0e6;
+
+  (void)number_of_variables;
+  if (i == 0) {
+    return shifted_x * shifted_x;
+  }
+  return condition * shifted_x * shifted_x;
+}
+
+static FORCE_INLINE double f_bent_cigar_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i;
+  double result = 0.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    result += f_bent_cigar_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+
+  return result;
+}
+
+static FORCE_INLINE double f_sharp_ridge_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  static const double alpha = 100.0;
+  const double d_vars_40 = 1.0; /* generalized: number_of_variables <= 40 ? 1 : number_of_variables / 40.0; */
+  const size_t vars_40 = 1;
+  size_t i = 0;
+  double result = 0.0;
+  double shifted_x;
+
+  for (i = vars_40; i < number_of_variables; ++i) {
+    shifted_x = x[i] - opt[i];
+    result += shifted_x * shifted_x;
+  }
+  result = alpha * sqrt(result / d_vars_40);
+  for (i = 0; i < vars_40; ++i) {
+    shifted_x = x[i] - opt[i];
+    result += shifted_x * shifted_x / d_vars_40;
+  }
+
+  return result;
+}
+
+static FORCE_INLINE double f_different_powers_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  double exponent = 2.0 + (4.0 * (double)(long)i) / ((double)(long)number_of_variables - 1.0);
+  return pow(fabs(shifted_x), exponent);
+}
+
+static FORCE_INLINE double f_different_powers_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  size_t i;
+  double sum = 0.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    sum += f_different_powers_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+
+  return sqrt(sum);
+}
+
+/**
+ * Sums table->sums[k] over the integer block of the encoded point x.
+ */
+static FORCE_INLINE double integer_table_sum(const double *x, size_t number_of_integer_variables, const integer_table_t *table, size_t k) {
+  const double *sums = table->sums[k];
+  const size_t stride = table->stride;
+  double result = 0.0;
+
+  for (size_t i = 0; i < number_of_integer_variables; ++i) {
+    result += sums[i * stride + (size_t)x[i]];
+  }
+  return result;
+}
+
+#define DEFINE_SEPARABLE_KERNELS(RAW) \
+  static double RAW##_table(const double *x, const size_t number_of_variables, const size_t number_of_integer_variables, const double *opt, const integer_table_t *table) { \
+    double result = integer_table_sum(x, number_of_integer_variables, table, 0); \
+    for (size_t i = number_of_integer_variables; i < number_of_variables; ++i) { \
+      result += RAW##_term(x[i] - opt[i], i, number_of_variables); \
+    } \
+    return result; \
+  } \
+  static const separable_kernel_t RAW##_kernel = {1, {RAW##_term, NULL}}; \
+  static void RAW##_delta_terms(const double *x, const double *opt, size_t i, size_t number_of_variables, double *t) { \
+    t[0] = RAW##_term(x[i] - opt[i], i, number_of_variables); \
+  } \
+  static double RAW##_delta_finalize(const double *sums, size_t number_of_variables) { \
+    (void)number_of_variables; \
+    return sums[0]; \
+  } \
+  static const delta_kernel_t RAW##_delta = {1, 0, RAW##_delta_terms};
+DEFINE_SEPARABLE_KERNELS(f_sphere_raw)
+DEFINE_SEPARABLE_KERNELS(f_ellipsoid_raw)
+DEFINE_SEPARABLE_KERNELS(f_bent_cigar_raw)
+#undef DEFINE_SEPARABLE_KERNELS
+
+static double f_rastrigin_raw_table(const double *x, const size_t number_of_variables, const size_t number_of_integer_variables, const double *opt, const integer_table_t *table) {
+  double sum1 = integer_table_sum(x, number_of_integer_variables, table, 0);
+  double sum2 = integer_table_sum(x, number_of_integer_variables, table, 1);
+  double shifted_x;
+
+  for (size_t i = number_of_integer_variables; i < number_of_variables; ++i) {
+    shifted_x = x[i] - opt[i];
+    sum1 += f_rastrigin_raw_cos_term(shifted_x, i, number_of_variables);
+    sum2 += f_sphere_raw_term(shifted_x, i, number_of_variables);
+  }
+  return f_rastrigin_raw_finalize(sum1, sum2, number_of_variables);
+}
+static const separable_kernel_t f_rastrigin_raw_kernel = {2, {f_rastrigin_raw_cos_term, f_sphere_raw_term}};
+
+static void f_rastrigin_raw_delta_terms(const double *x, const double *opt, size_t i, size_t number_of_variables, double *t) {
+  double shifted_x = x[i] - opt[i];
+  t[0] = f_rastrigin_raw_cos_term(shifted_x, i, number_of_variables);
+  t[1] = f_sphere_raw_term(shifted_x, i, number_of_variables);
+}
+
+static double f_rastrigin_raw_delta_finalize(const double *sums, size_t number_of_variables) {
+  return f_rastrigin_raw_finalize(sums[0], sums[1], number_of_variables);
+}
+static const delta_kernel_t f_rastrigin_raw_delta = {2, 0, f_rastrigin_raw_delta_terms};
+
+static double f_different_powers_raw_table(const double *x, const size_t number_of_variables, const size_t number_of_integer_variables, const double *opt, const integer_table_t *table) {
+  double sum = integer_table_sum(x, number_of_integer_variables, table, 0);
+
+  for (size_t i = number_of_integer_variables; i < number_of_variables; ++i) {
+    sum += f_different_powers_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+  return sqrt(sum);
+}
+static const separable_kernel_t f_different_powers_raw_kernel = {1, {f_different_powers_raw_term, NULL}};
+
+static void f_different_powers_raw_delta_terms(const double *x, const double *opt, size_t i, size_t number_of_variables, double *t) {
+  t[0] = f_different_powers_raw_term(x[i] - opt[i], i, number_of_variables);
+}
+
+static double f_different_powers_raw_delta_finalize(const double *sums, size_t number_of_variables) {
+  (void)number_of_variables;
+  return sqrt(sums[0]);
+}
+static const delta_kernel_t f_different_powers_raw_delta = {1, 0, f_different_powers_raw_delta_terms};
+
+/*
+ * Weierstrass: 10 (sum_i sum_k a^k cos(2 pi b^k (x_i + 0.5)) / n - f0)^3 with a = 0.5, b = 3,
+ * F_WEIERSTRASS_SUMMANDS summands and f0 = sum_k a^k cos(pi b^k) = -sum_k a^k. The terms are the
+ * distances e_k = cos(2 pi b^k (x_i + 0.5)) + 1 to the optimum, so the function is 10 (sum_i sum_k
+ * a^k e_k / n)^3 without cancellation near the optimum. As b = 3, the Chebyshev identity
+ * cos(3t) = 4 cos^3(t) - 3 cos(t) gives e_(k+1) = e_k (3 - 2 e_k)^2 from e_0 = 2 sin^2(pi x_i), so a
+ * coordinate costs one sine like rastrigin costs one cosine. An integral shifted coordinate is at
+ * the optimum for every k and contributes 0.
+ */
+#define F_WEIERSTRASS_SUMMANDS 12
+static const double f_weierstrass_ak[F_WEIERSTRASS_SUMMANDS] = {
+  1.0, 0.5, 0.25, 0.125, 0.0625, 0.03125, 0.015625, 0.0078125, 0.00390625, 0.001953125, 0.0009765625, 0.00048828125
+};
+
+static FORCE_INLINE double f_weierstrass_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  double e, result;
+
+  (void)i;
+  (void)number_of_variables;
+  if (shifted_x == floor(shifted_x)) {
+    return 0.0;
+  }
+  e = sin(coco_pi * shifted_x);
+  e = 2.0 * e * e;
+  result = f_weierstrass_ak[0] * e;
+  for (size_t k = 1; k < F_WEIERSTRASS_SUMMANDS; ++k) {
+    const double factor = 3.0 - 2.0 * e;
+    e *= factor * factor;
+    result += f_weierstrass_ak[k] * e;
+  }
+  return result;
+}
+
+static FORCE_INLINE double f_weierstrass_raw_finalize(double sum, size_t number_of_variables) {
+  const double result = sum / (double)(long)number_of_variables;
+  return 10.0 * result * result * result;
+}
+
+static FORCE_INLINE double f_weierstrass_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  double sum = 0.0;
+
+  for (size_t i = 0; i < number_of_variables; ++i) {
+    sum += f_weierstrass_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+  return f_weierstrass_raw_finalize(sum, number_of_variables);
+}
+
+/*
+ * Katsuura: 10 / n^2 (prod_i (1 + (i + 1) sum_{j=1}^{32} |2^j x_i - round(2^j x_i)| / 2^j)^(10 / n^1.2) - 1),
+ * written as a sum of logarithms so that it is separable like the other functions. The powers of two
+ * come from tables and 2^j x_i is rounded by adding and subtracting 1.5 * 2^52, which needs no call
+ * and lets the loop over j be vectorized (ties round to even instead of up, which does not change
+ * the distance to the nearest integer). An integral shifted coordinate has no fractional part at any
+ * scale and contributes 0.
+ */
+#define F_KATSUURA_SUMMANDS 32
+#define F_KATSUURA_ROUND 6755399441055744.0 //1.5 * 2^52: (v + F_KATSUURA_ROUND) - F_KATSUURA_ROUND rounds v for |v| < 2^51
+static const double f_katsuura_powers[F_KATSUURA_SUMMANDS] = { //2^j, j = 1..32
+  0x1p1, 0x1p2, 0x1p3, 0x1p4, 0x1p5, 0x1p6, 0x1p7, 0x1p8, 0x1p9, 0x1p10, 0x1p11, 0x1p12, 0x1p13,
+  0x1p14, 0x1p15, 0x1p16, 0x1p17, 0x1p18, 0x1p19, 0x1p20, 0x1p21, 0x1p22, 0x1p23, 0x1p24, 0x1p25,
+  0x1p26, 0x1p27, 0x1p28, 0x1p29, 0x1p30, 0x1p31, 0x1p32
+};
+static const double f_katsuura_inverse_powers[F_KATSUURA_SUMMANDS] = { //2^-j
+  0x1p-1, 0x1p-2, 0x1p-3, 0x1p-4, 0x1p-5, 0x1p-6, 0x1p-7, 0x1p-8, 0x1p-9, 0x1p-10, 0x1p-11, 0x1p-12,
+  0x1p-13, 0x1p-14, 0x1p-15, 0x1p-16, 0x1p-17, 0x1p-18, 0x1p-19, 0x1p-20, 0x1p-21, 0x1p-22, 0x1p-23,
+  0x1p-24, 0x1p-25, 0x1p-26, 0x1p-27, 0x1p-28, 0x1p-29, 0x1p-30, 0x1p-31, 0x1p-32
+};
+
+static FORCE_INLINE double f_katsuura_raw_term(double shifted_x, size_t i, size_t number_of_variables) {
+  double sum = 0.0;
+
+  if (shifted_x == floor(shifted_x)) {
+    return 0.0;
+  }
+  if (fabs(shifted_x) < 524288.0) { //2^19, so that 2^32 |x| < 2^51
+    for (size_t j = 0; j < F_KATSUURA_SUMMANDS; ++j) {
+      const double v = f_katsuura_powers[j] * shifted_x;
+      sum += fabs(v - ((v + F_KATSUURA_ROUND) - F_KATSUURA_ROUND)) * f_katsuura_inverse_powers[j];
+    }
+  }
+  else {
+    for (size_t j = 0; j < F_KATSUURA_SUMMANDS; ++j) {
+      const double v = f_katsuura_powers[j] * shifted_x;
+      sum += fabs(v - floor(v + 0.5)) * f_katsuura_inverse_powers[j];
+    }
+  }
+  return 10.0 / pow((double)number_of_variables, 1.2) * log1p((double)(long)(i + 1) * sum);
+}
+
+static FORCE_INLINE double f_katsuura_raw_finalize(double sum, size_t number_of_variables) {
+  const double n = (double)(long)number_of_variables;
+  return 10.0 / n / n * expm1(sum);
+}
+
+static FORCE_INLINE double f_katsuura_raw(const double *x, const size_t number_of_variables, const double *opt) {
+  double sum = 0.0;
+
+  for (size_t i = 0; i < number_of_variables; ++i) {
+    sum += f_katsuura_raw_term(x[i] - opt[i], i, number_of_variables);
+  }
+  return f_katsuura_raw_finalize(sum, number_of_variables);
+}
+
+/* Separable kernels of the functions that are RAW##_finalize of a sum of RAW##_term. */
+#define DEFINE_FINALIZED_SEPARABLE_KERNELS(RAW) \
+  static double RAW##_table(const double *x, const size_t number_of_variables, const size_t number_of_integer_variables, const double *opt, const integer_table_t *table) { \
+    double sum = integer_table_sum(x, number_of_integer_variables, table, 0); \
+    for (size_t i = number_of_integer_variables; i < number_of_variables; ++i) { \
+      sum += RAW##_term(x[i] - opt[i], i, number_of_variables); \
+    } \
+    return RAW##_finalize(sum, number_of_variables); \
+  } \
+  static const separable_kernel_t RAW##_kernel = {1, {RAW##_term, NULL}}; \
+  static void RAW##_delta_terms(const double *x, const double *opt, size_t i, size_t number_of_variables, double *t) { \
+    t[0] = RAW##_term(x[i] - opt[i], i, number_of_variables); \
+  } \
+  static double RAW##_delta_finalize(const double *sums, size_t number_of_variables) { \
+    return RAW##_finalize(sums[0], number_of_variables); \
+  } \
+  static const delta_kernel_t RAW##_delta = {1, 0, RAW##_delta_terms};
+DEFINE_FINALIZED_SEPARABLE_KERNELS(f_weierstrass_raw)
+DEFINE_FINALIZED_SEPARABLE_KERNELS(f_katsuura_raw)
+#undef DEFINE_FINALIZED_SEPARABLE_KERNELS
 
 
 // static double f_bueche_rastrigin_raw(const double *x, const size_t number_of_variables) {
@@ -1583,329 +5169,1511 @@ static double f_different_powers_raw(const double *x, const size_t number_of_var
 //     if (tmp > 0.0)
 //       penalty += tmp * tmp;
 //   }
-  
+  
+//   for (i = 0; i < number_of_variables; ++i) {
+//     double c1;
+//     data->x[i] = 0.0;
+//     c1 = sqrt(pow(condition / 10., (double) i / (double) (number_of_variables - 1)));
+//     for (j = 0; j < number_of_variables; ++j) {
+//       data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
+//     }
+//   }
+//   x1 = data->x[0];
+  
+//   for (i = 0; i < number_of_variables; ++i) {
+//     if (fabs(data->x[i]) > 0.5) /* TODO: Documentation: no fabs() in documentation */
+//       data->x[i] = coco_double_round(data->x[i]);
+//     else
+//       data->x[i] = coco_double_round(alpha * data->x[i]) / alpha;
+//   }
+  
+//   for (i = 0; i < number_of_variables; ++i) {
+//     data->xx[i] = 0.0;
+//     for (j = 0; j < number_of_variables; ++j) {
+//       data->xx[i] += data->rot1[i][j] * data->x[j];
+//     }
+//   }
+  
+//   /* Computation core */
+//   result = 0.0;
+//   for (i = 0; i < number_of_variables; ++i) {
+//     double exponent;
+//     exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
+//     result += pow(condition, exponent) * data->xx[i] * data->xx[i];
+//     ;
+//   }
+//   result = 0.1 * coco_double_max(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
+  
+//   return result;
+// }
+
+// static double f_discus_raw(const double *x, const size_t number_of_variables) {
+
+//   static const double condition = 1.0e6;
+//   size_t i;
+//   double result;
+  
+//   if (coco_vector_contains_nan(x, number_of_variables))
+//     return NAN;
+    
+//   result = condition * x[0] * x[0];
+//   for (i = 1; i < number_of_variables; ++i) {
+//     result += x[i] * x[i];
+//   }
+
+//   return result;
+// }
+
+// static double f_schaffers_raw(const double *x, const size_t number_of_variables) {
+
+//   size_t i = 0;
+//   double result;
+
+//   assert(number_of_variables > 1);
+
+//   if (coco_vector_contains_nan(x, number_of_variables))
+//   	return NAN;
+
+//   /* Computation core */
+//   result = 0.0;
+//   for (i = 0; i < number_of_variables - 1; ++i) {
+//     const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+//     if (coco_is_inf(tmp) && coco_is_nan(sin(50.0 * pow(tmp, 0.1))))  /* sin(inf) -> nan */
+//       /* the second condition is necessary to pass the integration tests under Windows and Linux */
+//       return tmp;
+//     result += pow(tmp, 0.25) * (1.0 + pow(sin(50.0 * pow(tmp, 0.1)), 2.0));
+//   }
+//   result = pow(result / ((double) (long) number_of_variables - 1.0), 2.0);
+
+//   return result;
+// }
+
+// static double f_griewank_rosenbrock_raw(const double *x, const size_t number_of_variables) {
+
+//   size_t i = 0;
+//   double tmp = 0;
+//   double result;
+
+//   if (coco_vector_contains_nan(x, number_of_variables))
+//   	return NAN;
+
+//   /* Computation core */
+//   result = 0.0;
+//   for (i = 0; i < number_of_variables - 1; ++i) {
+//     const double c1 = x[i] * x[i] - x[i + 1];
+//     const double c2 = 1.0 - x[i];
+//     tmp = 100.0 * c1 * c1 + c2 * c2;
+//     result += tmp / 4000. - cos(tmp);
+//   }
+//   result = 10. + 10. * result / (double) (number_of_variables - 1);
+
+//   return result;
+// }
+
+// static double f_schwefel_raw(const double *x, const size_t number_of_variables) {
+
+//   size_t i = 0;
+//   double result;
+//   double penalty, sum;
+
+//   if (coco_vector_contains_nan(x, number_of_variables))
+//   	return NAN;
+
+//   /* Boundary handling*/
+//   penalty = 0.0;
+//   for (i = 0; i < number_of_variables; ++i) {
+//     const double tmp = fabs(x[i]) - 500.0;
+//     if (tmp > 0.0)
+//       penalty += tmp * tmp;
+//   }
+
+//   /* Computation core */
+//   sum = 0.0;
+//   for (i = 0; i < number_of_variables; ++i) {
+//     sum += x[i] * sin(sqrt(fabs(x[i])));
+//   }
+//   result = 0.01 * (penalty + 418.9828872724339 - sum / (double) number_of_variables);
+
+//   return result;
+// }
+
+// static double f_lunacek_bi_rastrigin_raw(const double *x,
+//                                          const size_t number_of_variables,
+//                                          f_lunacek_bi_rastrigin_data_t *data) {
+//   double result;
+//   static const double condition = 100.;
+//   size_t i, j;
+//   double penalty = 0.0;
+//   static const double mu0 = 2.5;
+//   static const double d = 1.;
+//   const double s = 1. - 0.5 / (sqrt((double) (number_of_variables + 20)) - 4.1);
+//   const double mu1 = -sqrt((mu0 * mu0 - d) / s);
+//   double *tmpvect, sum1 = 0., sum2 = 0., sum3 = 0.;
+
+//   assert(number_of_variables > 1);
+
+//   if (coco_vector_contains_nan(x, number_of_variables))
+//   	return NAN;
+
+//   for (i = 0; i < number_of_variables; ++i) {
+//     double tmp;
+//     tmp = fabs(x[i]) - 5.0;
+//     if (tmp > 0.0)
+//       penalty += tmp * tmp;
+//   }
+
+//   /* x_hat */
+//   for (i = 0; i < number_of_variables; ++i) {
+//     data->x_hat[i] = 2. * x[i];
+//     if (data->xopt[i] < 0.) {
+//       data->x_hat[i] *= -1.;
+//     }
+//   }
+
+//   tmpvect = coco_allocate_vector(number_of_variables);
+//   /* affine transformation */
 //   for (i = 0; i < number_of_variables; ++i) {
 //     double c1;
-//     data->x[i] = 0.0;
-//     c1 = sqrt(pow(condition / 10., (double) i / (double) (number_of_variables - 1)));
+//     tmpvect[i] = 0.0;
+//     c1 = pow(sqrt(condition), ((double) i) / (double) (number_of_variables - 1));
 //     for (j = 0; j < number_of_variables; ++j) {
-//       data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
+//       tmpvect[i] += c1 * data->rot2[i][j] * (data->x_hat[j] - mu0);
 //     }
 //   }
-//   x1 = data->x[0];
-  
-//   for (i = 0; i < number_of_variables; ++i) {
-//     if (fabs(data->x[i]) > 0.5) /* TODO: Documentation: no fabs() in documentation */
-//       data->x[i] = coco_double_round(data->x[i]);
-//     else
-//       data->x[i] = coco_double_round(alpha * data->x[i]) / alpha;
-//   }
-  
 //   for (i = 0; i < number_of_variables; ++i) {
-//     data->xx[i] = 0.0;
+//     data->z[i] = 0;
 //     for (j = 0; j < number_of_variables; ++j) {
-//       data->xx[i] += data->rot1[i][j] * data->x[j];
+//       data->z[i] += data->rot1[i][j] * tmpvect[j];
 //     }
 //   }
-  
 //   /* Computation core */
-//   result = 0.0;
 //   for (i = 0; i < number_of_variables; ++i) {
-//     double exponent;
-//     exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
-//     result += pow(condition, exponent) * data->xx[i] * data->xx[i];
-//     ;
+//     sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
+//     sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
+//     sum3 += cos(2 * coco_pi * data->z[i]);
 //   }
-//   result = 0.1 * coco_double_max(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
-  
+//   result = coco_double_min(sum1, d * (double) number_of_variables + s * sum2)
+//       + 10. * ((double) number_of_variables - sum3) + 1e4 * penalty;
+//   coco_free_memory(tmpvect);
+
 //   return result;
 // }
 
-// static double f_discus_raw(const double *x, const size_t number_of_variables) {
+/**
+ * Built-in functions of the custom suite: name, raw function, scaling of the raw value and structure
+ * of the raw function: 0 for none, 1 if it is separable (RAW##_table and RAW##_kernel exist, see
+ * my_problem_prepare), 2 if it is a chain. Separable and chain functions have a delta kernel
+ * (RAW##_delta and RAW##_delta_finalize, see de_delta_new). Every function is also instantiated for
+ * the fixed dimensions, see select_evaluate.
+ */
+#define BUILTIN_FUNCTIONS(X) \
+  X(f1, f_sphere_raw, 1, 1) \
+  X(f2, f_ellipsoid_raw, pow(10, -3), 1) \
+  X(f3, f_rastrigin_raw, 0.1, 1) \
+  X(f8, f_rosenbrock_raw, pow(10, -2), 2) \
+  X(f12, f_bent_cigar_raw, pow(10, -4), 1) \
+  X(f13, f_sharp_ridge_raw, 0.1, 0) \
+  X(f14, f_different_powers_raw, 1, 1) \
+  X(f16, f_weierstrass_raw, 1, 1) \
+  X(f23, f_katsuura_raw, 1, 1)
+
+#define BUILTIN_DEFINE_FIXED_EVALUATE(D, NAME, RAW, SCALE) \
+  static double NAME##_evaluate_##D(const double *x, size_t dimension, const double *optimal) { \
+    (void)dimension; \
+    return RAW(x, D, optimal) * SCALE; \
+  }
+#define BUILTIN_DEFINE_DELTA_FINALIZE(NAME, RAW, SCALE) \
+  static double NAME##_delta_finalize(const double *sums, size_t dimension) { \
+    return RAW##_delta_finalize(sums, dimension) * SCALE; \
+  }
+#define BUILTIN_DEFINE_STRUCTURED_EVALUATE_0(NAME, RAW, SCALE)
+#define BUILTIN_DEFINE_STRUCTURED_EVALUATE_1(NAME, RAW, SCALE) \
+  static double NAME##_table_evaluate(const double *x, size_t dimension, size_t number_of_integer_variables, const double *optimal, const integer_table_t *table) { \
+    return RAW##_table(x, dimension, number_of_integer_variables, optimal, table) * SCALE; \
+  } \
+  static void NAME##_evaluate_columns(const double *columns, double *sums, size_t number_of_points, size_t first, size_t dimension, double *y) { \
+    for (size_t j = first; j < dimension; j++) { \
+      const double *column = columns + j * COLUMN_TILE; \
+      for (size_t p = 0; p < number_of_points; p++) { \
+        sums[p] += RAW##_kernel.term[0](column[p], j, dimension); \
+      } \
+      if (RAW##_kernel.number_of_sums > 1) { \
+        for (size_t p = 0; p < number_of_points; p++) { \
+          sums[COLUMN_TILE + p] += RAW##_kernel.term[1](column[p], j, dimension); \
+        } \
+      } \
+    } \
+    for (size_t p = 0; p < number_of_points; p++) { \
+      const double point_sums[2] = {sums[p], sums[COLUMN_TILE + p]}; \
+      y[p] = RAW##_delta_finalize(point_sums, dimension) * SCALE; \
+    } \
+  } \
+  BUILTIN_DEFINE_DELTA_FINALIZE(NAME, RAW, SCALE)
+#define BUILTIN_DEFINE_STRUCTURED_EVALUATE_2(NAME, RAW, SCALE) BUILTIN_DEFINE_DELTA_FINALIZE(NAME, RAW, SCALE)
+#define BUILTIN_DEFINE_EVALUATE(NAME, RAW, SCALE, STRUCTURE) \
+  static double NAME##_evaluate(const double *x, size_t dimension, const double *optimal) { \
+    return RAW(x, dimension, optimal) * SCALE; \
+  } \
+  FIXED_DIMENSIONS(BUILTIN_DEFINE_FIXED_EVALUATE, NAME, RAW, SCALE) \
+  BUILTIN_DEFINE_STRUCTURED_EVALUATE_##STRUCTURE(NAME, RAW, SCALE)
+BUILTIN_FUNCTIONS(BUILTIN_DEFINE_EVALUATE)
+#undef BUILTIN_DEFINE_EVALUATE
+#undef BUILTIN_DEFINE_STRUCTURED_EVALUATE_2
+#undef BUILTIN_DEFINE_STRUCTURED_EVALUATE_1
+#undef BUILTIN_DEFINE_STRUCTURED_EVALUATE_0
+#undef BUILTIN_DEFINE_DELTA_FINALIZE
+#undef BUILTIN_DEFINE_FIXED_EVALUATE
 
-//   static const double condition = 1.0e6;
-//   size_t i;
-//   double result;
-  
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//     return NAN;
-    
-//   result = condition * x[0] * x[0];
-//   for (i = 1; i < number_of_variables; ++i) {
-//     result += x[i] * x[i];
-//   }
+/**
+ * Built-in functions of the custom suite. They use the built-in variable layout
+ * (declare_variables == NULL) and have no batch entry point.
+ */
+#define BUILTIN_FUNCTION_ENTRY(NAME, RAW, SCALE, STRUCTURE) {#NAME, NULL, NAME##_evaluate, NULL},
+static const my_plugin_function_t builtin_functions[] = {
+  BUILTIN_FUNCTIONS(BUILTIN_FUNCTION_ENTRY)
+};
+#undef BUILTIN_FUNCTION_ENTRY
 
-//   return result;
-// }
+/**
+ * Rotated variants of built-in functions: name and base function. A problem of a rotated function
+ * evaluates the base function at z = R (x - optimal) with the optimum at z = 0, where R is a
+ * rotation matrix drawn per problem (see my_problem_prepare). The optimum stays at the optimal point
+ * but the variables are no longer separable, so the lookup tables and delta kernels of the base
+ * function do not apply. The evaluate entry point is the one of the base function, in the rotated
+ * coordinates.
+ */
+#define ROTATED_FUNCTIONS(X) \
+  X(f2r, f2) \
+  X(f3r, f3) \
+  X(f12r, f12) \
+  X(f13r, f13) \
+  X(f14r, f14)
+
+#define ROTATED_FUNCTION_ENTRY(NAME, BASE) {#NAME, NULL, BASE##_evaluate, NULL},
+static const my_plugin_function_t rotated_functions[] = {
+  ROTATED_FUNCTIONS(ROTATED_FUNCTION_ENTRY)
+};
+#undef ROTATED_FUNCTION_ENTRY
+#define ROTATED_BASE_ENTRY(NAME, BASE) #BASE,
+static const char *const rotated_base_names[] = {
+  ROTATED_FUNCTIONS(ROTATED_BASE_ENTRY)
+};
+#undef ROTATED_BASE_ENTRY
+
+/**
+ * Gallagher functions: name and number of peaks. Their peaks are drawn per problem together with a
+ * rotation (see my_problem_prepare), so they are only evaluated through my_evaluate_population and
+ * my_evaluate_point.
+ */
+#define GALLAGHER_FUNCTIONS(X) \
+  X(f21, 101) \
+  X(f22, 21)
+
+static double gallagher_unprepared_evaluate(const double *x, size_t dimension, const double *optimal) {
+  (void)x;
+  (void)dimension;
+  (void)optimal;
+  fprintf(stderr, "Gallagher functions are only evaluated on prepared problems (my_problem_prepare).\n");
+  exit(EXIT_FAILURE);
+}
 
-// static double f_weierstrass_raw(const double *x, const size_t number_of_variables, f_weierstrass_data_t *data) {
+#define GALLAGHER_FUNCTION_ENTRY(NAME, PEAKS) {#NAME, NULL, gallagher_unprepared_evaluate, NULL},
+static const my_plugin_function_t gallagher_functions[] = {
+  GALLAGHER_FUNCTIONS(GALLAGHER_FUNCTION_ENTRY)
+};
+#undef GALLAGHER_FUNCTION_ENTRY
+#define GALLAGHER_PEAKS_ENTRY(NAME, PEAKS) PEAKS,
+static const size_t gallagher_peaks[] = {
+  GALLAGHER_FUNCTIONS(GALLAGHER_PEAKS_ENTRY)
+};
+#undef GALLAGHER_PEAKS_ENTRY
 
-//   size_t i, j;
-//   double result;
+/**
+ * Table-driven and column entry points of the separable built-in functions and delta kernels of the
+ * separable and chain ones, NULL for the others. The column entry point evaluates a tile of at most
+ * COLUMN_TILE points whose shifted coordinates first..dimension-1 are stored coordinate by
+ * coordinate (columns[j*COLUMN_TILE + p]): it adds their terms to the sums of the points
+ * (sums[k*COLUMN_TILE + p], initially the sums of the integer block) and finalizes them into y.
+ */
+typedef struct builtin_structure{
+  const separable_kernel_t *kernel;
+  my_table_evaluate_t table_evaluate;
+  const delta_kernel_t *delta;
+  delta_finalize_t delta_finalize;
+  void (*evaluate_columns)(const double *columns, double *sums, size_t number_of_points, size_t first, size_t dimension, double *y);
+}builtin_structure_t;
+#define BUILTIN_STRUCTURE_ENTRY_0(NAME, RAW) {NULL, NULL, NULL, NULL, NULL},
+#define BUILTIN_STRUCTURE_ENTRY_1(NAME, RAW) {&RAW##_kernel, NAME##_table_evaluate, &RAW##_delta, NAME##_delta_finalize, NAME##_evaluate_columns},
+#define BUILTIN_STRUCTURE_ENTRY_2(NAME, RAW) {NULL, NULL, &RAW##_delta, NAME##_delta_finalize, NULL},
+#define BUILTIN_STRUCTURE_ENTRY(NAME, RAW, SCALE, STRUCTURE) BUILTIN_STRUCTURE_ENTRY_##STRUCTURE(NAME, RAW)
+static const builtin_structure_t builtin_structure[] = {
+  BUILTIN_FUNCTIONS(BUILTIN_STRUCTURE_ENTRY)
+};
+#undef BUILTIN_STRUCTURE_ENTRY
+#undef BUILTIN_STRUCTURE_ENTRY_2
+#undef BUILTIN_STRUCTURE_ENTRY_1
+#undef BUILTIN_STRUCTURE_ENTRY_0
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+/**
+ * Returns the structure of the built-in function, or NULL for plugin functions.
+ */
+static const builtin_structure_t *find_builtin_structure(const my_plugin_function_t *function) {
+  for (size_t i = 0; i < sizeof(builtin_functions) / sizeof(builtin_functions[0]); i++) {
+    if (function == &builtin_functions[i]) {
+      return &builtin_structure[i];
+    }
+  }
+  return NULL;
+}
+
+#define FIXED_DIMENSION_VALUE(D, ...) D,
+#define BUILTIN_FIXED_EVALUATE_ENTRY(D, NAME) NAME##_evaluate_##D,
+#define BUILTIN_FIXED_EVALUATE_ROW(NAME, RAW, SCALE, STRUCTURE) {FIXED_DIMENSIONS(BUILTIN_FIXED_EVALUATE_ENTRY, NAME)},
+static const size_t fixed_dimensions[] = {FIXED_DIMENSIONS(FIXED_DIMENSION_VALUE, ~)};
+static double (*const builtin_fixed_evaluate[][NUMBER_OF_FIXED_DIMENSIONS])(const double *, size_t, const double *) = {
+  BUILTIN_FUNCTIONS(BUILTIN_FIXED_EVALUATE_ROW)
+};
+#undef BUILTIN_FIXED_EVALUATE_ROW
+#undef BUILTIN_FIXED_EVALUATE_ENTRY
+#undef FIXED_DIMENSION_VALUE
+
+/**
+ * Returns the number of peaks of a Gallagher function, or 0 for other functions.
+ */
+static size_t gallagher_number_of_peaks(const my_plugin_function_t *function) {
+  for (size_t i = 0; i < sizeof(gallagher_functions) / sizeof(gallagher_functions[0]); i++) {
+    if (function == &gallagher_functions[i]) {
+      return gallagher_peaks[i];
+    }
+  }
+  return 0;
+}
+
+/**
+ * Returns the base function of a rotated function, or NULL for other functions.
+ */
+static const my_plugin_function_t *rotated_base(const my_plugin_function_t *function) {
+  for (size_t i = 0; i < sizeof(rotated_functions) / sizeof(rotated_functions[0]); i++) {
+    if (function == &rotated_functions[i]) {
+      return find_builtin_function(rotated_base_names[i]);
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Returns the scalar entry point used for problems of the function in the given dimension: the
+ * fixed-dimension instantiation for built-in functions (of the base function for rotated ones),
+ * function->evaluate otherwise.
+ */
+my_evaluate_t select_evaluate(const my_plugin_function_t *function, size_t dimension) {
+  const size_t number_of_builtin_functions = sizeof(builtin_functions) / sizeof(builtin_functions[0]);
+  const my_plugin_function_t *base = rotated_base(function);
+  if (base != NULL) {
+    function = base;
+  }
+  for (size_t i = 0; i < number_of_builtin_functions; i++) {
+    if (function != &builtin_functions[i]) {
+      continue;
+    }
+    for (size_t j = 0; j < NUMBER_OF_FIXED_DIMENSIONS; j++) {
+      if (fixed_dimensions[j] == dimension) {
+        return builtin_fixed_evaluate[i][j];
+      }
+    }
+  }
+  return function->evaluate;
+}
+
+/**
+ * Seed of the rotation matrix of the problem: a hash of its function, integer ratio, range,
+ * dimension and instance, so the matrix depends neither on the order in which the problems are
+ * generated or run nor on the catalog.
+ */
+static uint32_t rotation_seed(const MY_PROBLEM *problem) {
+  const uint64_t values[4] = {problem->r, (uint64_t)problem->largest[0], problem->dimension, problem->instance};
+  uint64_t hash = 14695981039346656037ULL; //FNV-1a
+  const char *c;
+
+  for (c = problem->function_name; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+  }
+  for (size_t k = 0; k < 4; k++) {
+    hash = (hash ^ values[k]) * 1099511628211ULL;
+  }
+  return (uint32_t)(hash ^ (hash >> 32)) ^ RANDOM_SEED;
+}
+
+/**
+ * Draws a random rotation matrix (row-major) like bbob2009_compute_rotation in COCO: a standard
+ * normal matrix whose rows are orthonormalized by Gram-Schmidt.
+ */
+static void compute_rotation(double *rotation, size_t dimension, uint32_t seed) {
+  coco_random_state_t *random_generator = coco_random_new(seed);
+
+  for (size_t i = 0; i < dimension * dimension; i++) {
+    rotation[i] = coco_random_normal(random_generator);
+  }
+  for (size_t i = 0; i < dimension; i++) {
+    double *row = rotation + i * dimension;
+    double norm = 0;
+    for (size_t k = 0; k < i; k++) {
+      const double *previous = rotation + k * dimension;
+      double dot = 0;
+      for (size_t j = 0; j < dimension; j++) {
+        dot += row[j] * previous[j];
+      }
+      for (size_t j = 0; j < dimension; j++) {
+        row[j] -= dot * previous[j];
+      }
+    }
+    for (size_t j = 0; j < dimension; j++) {
+      norm += row[j] * row[j];
+    }
+    norm = sqrt(norm);
+    for (size_t j = 0; j < dimension; j++) {
+      row[j] /= norm;
+    }
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Stores M s for the number_of_points rows s of points (dimension doubles each) in the rows of
+ * products (number_of_rows doubles each), i.e. the matrix product points M^T for the
+ * number_of_rows x dimension matrix M. The product is blocked into ROTATION_TILE x ROTATION_TILE
+ * tiles of M, which stay in cache while all points pass through them, and four rows of M are
+ * applied at once so that every value of a point is loaded once per four outputs. Each output is
+ * summed over the tiles in the same order whatever the number of points, so a point multiplied
+ * alone gets the same value as within its population.
+ */
+static void multiply_points(const double *matrix, size_t number_of_rows, const double *points, double *products, size_t number_of_points, size_t dimension) {
+  memset(products, 0, number_of_points * number_of_rows * sizeof(double));
+  for (size_t i0 = 0; i0 < number_of_rows; i0 += ROTATION_TILE) {
+    const size_t i1 = i0 + ROTATION_TILE < number_of_rows ? i0 + ROTATION_TILE : number_of_rows;
+    for (size_t j0 = 0; j0 < dimension; j0 += ROTATION_TILE) {
+      const size_t j1 = j0 + ROTATION_TILE < dimension ? j0 + ROTATION_TILE : dimension;
+      for (size_t p = 0; p < number_of_points; p++) {
+        const double *s = points + p * dimension;
+        double *z = products + p * number_of_rows;
+        size_t i = i0;
+        for (; i + 4 <= i1; i += 4) {
+          const double *r0 = matrix + i * dimension;
+          const double *r1 = r0 + dimension;
+          const double *r2 = r1 + dimension;
+          const double *r3 = r2 + dimension;
+          double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+          for (size_t j = j0; j < j1; j++) {
+            a0 += r0[j] * s[j];
+            a1 += r1[j] * s[j];
+            a2 += r2[j] * s[j];
+            a3 += r3[j] * s[j];
+          }
+          z[i] += a0;
+          z[i + 1] += a1;
+          z[i + 2] += a2;
+          z[i + 3] += a3;
+        }
+        for (; i < i1; i++) {
+          const double *r0 = matrix + i * dimension;
+          double a0 = 0;
+          for (size_t j = j0; j < j1; j++) {
+            a0 += r0[j] * s[j];
+          }
+          z[i] += a0;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Stores a random permutation of 0, ..., n - 1 in permutation.
+ */
+static void random_permutation(size_t *permutation, size_t n, coco_random_state_t *random_generator) {
+  for (size_t i = 0; i < n; i++) {
+    permutation[i] = i;
+  }
+  for (size_t i = n; i > 1; i--) {
+    size_t j = (size_t)(coco_random_uniform(random_generator) * (double)i);
+    size_t tmp;
+    if (j >= i) {
+      j = i - 1;
+    }
+    tmp = permutation[i - 1];
+    permutation[i - 1] = permutation[j];
+    permutation[j] = tmp;
+  }
+}
+
+/**
+ * Draws the peaks of a Gallagher function like f_gallagher in COCO: peak values 10 for the first
+ * peak and evenly spaced in [1.1, 9.1] for the others, conditions of 1000 to a random power per
+ * peak (sqrt(1000) or 1000 for the first one) spread over the coordinates in random order, and
+ * uniform centers in [-5, 5]^n (101 peaks) or [-4.9, 4.9]^n (21 peaks), rotated with the rotation
+ * of the problem. The first peak is centered at the optimum, so it is the optimal point of the
+ * problem with value 0.
+ */
+static gallagher_t *gallagher_new(const MY_PROBLEM *problem, size_t number_of_peaks) {
+  const size_t dimension = problem->dimension;
+  const double max_condition = 1000.0;
+  const double first_condition = number_of_peaks == 101 ? sqrt(max_condition) : max_condition;
+  const double b = number_of_peaks == 101 ? 10.0 : 9.8;
+  const double c = number_of_peaks == 101 ? 5.0 : 4.9;
+  coco_random_state_t *random_generator = coco_random_new(rotation_seed(problem) + 1);
+  gallagher_t *gallagher = (gallagher_t *)coco_allocate_memory(sizeof(*gallagher));
+  double *arena = coco_allocate_vector(2 * number_of_peaks * dimension + 2 * number_of_peaks
+                                       + DE_N * dimension + 2 * DE_N * number_of_peaks);
+  double *centers = coco_allocate_vector(number_of_peaks * dimension);
+  double *uniform = coco_allocate_vector(number_of_peaks * dimension);
+  size_t *permutation = (size_t *)malloc((number_of_peaks > dimension ? number_of_peaks : dimension) * sizeof(size_t));
+
+  if (permutation == NULL) {
+    fprintf(stderr, "Memory allocation failed for gallagher.\n");
+    exit(EXIT_FAILURE);
+  }
+  gallagher->number_of_peaks = number_of_peaks;
+  gallagher->scales = arena;
+  gallagher->scaled_centers = gallagher->scales + number_of_peaks * dimension;
+  gallagher->offsets = gallagher->scaled_centers + number_of_peaks * dimension;
+  gallagher->log_ratios = gallagher->offsets + number_of_peaks;
+  gallagher->squares = gallagher->log_ratios + number_of_peaks;
+  gallagher->products = gallagher->squares + DE_N * dimension;
+
+  /* peak values and conditions */
+  random_permutation(permutation, number_of_peaks - 1, random_generator);
+  for (size_t i = 0; i < number_of_peaks; i++) {
+    const double value = i == 0 ? 10.0 : 1.1 + 8.0 * (double)(i - 1) / (double)(number_of_peaks - 2);
+    const double condition = i == 0 ? first_condition : pow(max_condition, (double)permutation[i - 1] / (double)(number_of_peaks - 2));
+    gallagher->log_ratios[i] = log(value / 10.0);
+    centers[i] = condition; //kept until the scales are drawn
+  }
+  for (size_t i = 0; i < number_of_peaks; i++) {
+    const double condition = centers[i];
+    random_permutation(permutation, dimension, random_generator);
+    for (size_t j = 0; j < dimension; j++) {
+      gallagher->scales[i * dimension + j] = pow(condition, (double)permutation[j] / (double)(dimension - 1) - 0.5);
+    }
+  }
+  /* centers, rotated like the points */
+  for (size_t k = 0; k < number_of_peaks * dimension; k++) {
+    uniform[k] = k < dimension ? 0.0 : b * coco_random_uniform(random_generator) - c;
+  }
+  multiply_points(problem->rotation, dimension, uniform, centers, number_of_peaks, dimension);
+  for (size_t i = 0; i < number_of_peaks; i++) {
+    double offset = 0.0;
+    for (size_t j = 0; j < dimension; j++) {
+      const double scale = gallagher->scales[i * dimension + j];
+      const double center = centers[i * dimension + j];
+      gallagher->scaled_centers[i * dimension + j] = scale * center;
+      offset += scale * center * center;
+    }
+    gallagher->offsets[i] = offset;
+  }
+
+  free(permutation);
+  coco_free_memory(uniform);
+  coco_free_memory(centers);
+  coco_random_free(random_generator);
+  return gallagher;
+}
+
+static void gallagher_free(gallagher_t *gallagher) {
+  coco_free_memory(gallagher->scales);
+  coco_free_memory(gallagher);
+}
+
+/**
+ * Value of a Gallagher function from f = 10 - max_i v_i exp(-0.5 / n d_i(z)) >= 0, with the
+ * oscillation of f_gallagher in COCO: (f exp(0.049 (sin(t) + sin(0.79 t))))^2 for t = 10 log(f).
+ */
+static double gallagher_finalize(double f) {
+  double t;
+
+  if (f <= 0.0) {
+    return 0.0;
+  }
+  t = 10.0 * log(f);
+  f *= exp(0.049 * (sin(t) + sin(0.79 * t)));
+  return f * f;
+}
+
+/**
+ * Evaluates number_of_points rotated points (rows of dimension doubles) of a Gallagher function.
+ * The scaled squared distances d_i(z) = sum_j s_ij (z_j - c_ij)^2 to all peaks are
+ * sum_j s_ij z_j^2 - 2 sum_j s_ij c_ij z_j + sum_j s_ij c_ij^2, i.e. two products of the batch with
+ * the scales and the scaled centers (see multiply_points). The largest peak is found on
+ * log(v_i / v_0) - 0.5 / n d_i, so a point needs one exponential however many peaks there are, and
+ * the first peak, centered at 0, is computed without cancellation.
+ */
+static void gallagher_evaluate_rotated(const gallagher_t *gallagher, const double *rotated, size_t number_of_points, size_t dimension, double *y) {
+  const size_t number_of_peaks = gallagher->number_of_peaks;
+  const double factor = -0.5 / (double)dimension;
+  double *distances = gallagher->products;
+  double *cross = gallagher->products + DE_N * number_of_peaks;
+
+  for (size_t k = 0; k < number_of_points * dimension; k++) {
+    gallagher->squares[k] = rotated[k] * rotated[k];
+  }
+  multiply_points(gallagher->scales, number_of_peaks, gallagher->squares, distances, number_of_points, dimension);
+  multiply_points(gallagher->scaled_centers, number_of_peaks, rotated, cross, number_of_points, dimension);
+  for (size_t p = 0; p < number_of_points; p++) {
+    const double *d = distances + p * number_of_peaks;
+    const double *x = cross + p * number_of_peaks;
+    double best = factor * d[0];
+    for (size_t i = 1; i < number_of_peaks; i++) {
+      double distance = d[i] - 2.0 * x[i] + gallagher->offsets[i];
+      double value;
+      if (distance < 0.0) {
+        distance = 0.0;
+      }
+      value = gallagher->log_ratios[i] + factor * distance;
+      if (value > best) {
+        best = value;
+      }
+    }
+    y[p] = gallagher_finalize(-10.0 * expm1(best));
+  }
+}
+
+/**
+ * Evaluates number_of_points decoded points of a problem of a rotated or Gallagher function, DE_N
+ * points per matrix product.
+ */
+static void my_evaluate_rotated(const MY_PROBLEM *problem, const double *const *x, size_t number_of_points, double *y) {
+  const size_t dimension = problem->dimension;
+  double *shifted = problem->rotation_scratch;
+  double *rotated = shifted + DE_N * dimension;
+  const double *zero = rotated + DE_N * dimension;
+
+  for (size_t first = 0; first < number_of_points; first += DE_N) {
+    const size_t count = number_of_points - first < DE_N ? number_of_points - first : DE_N;
+    for (size_t p = 0; p < count; p++) {
+      for (size_t j = 0; j < dimension; j++) {
+        shifted[p * dimension + j] = x[first + p][j] - problem->optimal[j];
+      }
+    }
+    multiply_points(problem->rotation, dimension, shifted, rotated, count, dimension);
+    if (problem->gallagher != NULL) {
+      gallagher_evaluate_rotated(problem->gallagher, rotated, count, dimension, y + first);
+      continue;
+    }
+    for (size_t p = 0; p < count; p++) {
+      y[first + p] = problem->evaluate(rotated + p * dimension, dimension, zero);
+    }
+  }
+}
+
+/**
+ * Draws the rotation matrix of the problem if its function is rotated, and the peaks if it is a
+ * Gallagher function. Otherwise builds the lookup
+ * table of the integer block if the function of the problem is a separable built-in function, so
+ * that my_evaluate_population replaces the arithmetic of the integer coordinates by table lookups.
+ * The table holds the terms of every (coordinate, value) pair for the optimal solution of the
+ * problem. The rotation, the peaks and the table are only kept while the problem runs.
+ */
+void my_problem_prepare(MY_PROBLEM *problem) {
+  const size_t number_of_integer_variables = problem->number_of_integer_variables;
+  const builtin_structure_t *separable = find_builtin_structure(problem->function);
+  const separable_kernel_t *kernel;
+  integer_table_t *table;
+  size_t i, k, v;
+
+  const size_t number_of_peaks = gallagher_number_of_peaks(problem->function);
+
+  if ((rotated_base(problem->function) != NULL || number_of_peaks > 0) && problem->rotation == NULL) {
+    problem->rotation = coco_allocate_vector(problem->dimension * problem->dimension);
+    problem->rotation_scratch = coco_allocate_vector((2 * DE_N + 1) * problem->dimension);
+    compute_rotation(problem->rotation, problem->dimension, rotation_seed(problem));
+    for (i = 0; i < problem->dimension; i++) {
+      problem->rotation_scratch[2 * DE_N * problem->dimension + i] = 0;
+    }
+  }
+  if (number_of_peaks > 0 && problem->gallagher == NULL) {
+    problem->gallagher = gallagher_new(problem, number_of_peaks);
+  }
+  if (separable == NULL || separable->kernel == NULL || number_of_integer_variables == 0 || problem->integer_table != NULL) {
+    return;
+  }
+  kernel = separable->kernel;
+
+  table = (integer_table_t *)malloc(sizeof(integer_table_t));
+  if (table == NULL) {
+    fprintf(stderr, "Memory allocation failed for integer_table.\n");
+    exit(EXIT_FAILURE);
+  }
+  table->stride = 0;
+  for (i = 0; i < number_of_integer_variables; i++) {
+    if ((size_t)problem->largest[i] + 1 > table->stride) {
+      table->stride = (size_t)problem->largest[i] + 1;
+    }
+  }
+  for (k = 0; k < 2; k++) {
+    table->sums[k] = NULL;
+  }
+  for (k = 0; k < kernel->number_of_sums; k++) {
+    table->sums[k] = coco_allocate_vector(number_of_integer_variables * table->stride);
+    for (i = 0; i < number_of_integer_variables; i++) {
+      for (v = 0; v < table->stride; v++) {
+        table->sums[k][i * table->stride + v] = kernel->term[k]((double)v - problem->optimal[i], i, problem->dimension);
+      }
+    }
+  }
+  problem->integer_table = table;
+  problem->table_evaluate = separable->table_evaluate;
+}
+
+void my_problem_release(MY_PROBLEM *problem) {
+  if (problem->gallagher != NULL) {
+    gallagher_free(problem->gallagher);
+    problem->gallagher = NULL;
+  }
+  if (problem->rotation != NULL) {
+    coco_free_memory(problem->rotation);
+    coco_free_memory(problem->rotation_scratch);
+    problem->rotation = NULL;
+    problem->rotation_scratch = NULL;
+  }
+  if (problem->integer_table == NULL) {
+    return;
+  }
+  for (size_t k = 0; k < 2; k++) {
+    if (problem->integer_table->sums[k] != NULL) {
+      coco_free_memory(problem->integer_table->sums[k]);
+    }
+  }
+  free(problem->integer_table);
+  problem->integer_table = NULL;
+  problem->table_evaluate = NULL;
+}
+
+/**
+ * Returns the built-in, rotated built-in or Gallagher function with the given name, or NULL.
+ */
+const my_plugin_function_t *find_builtin_function(const char *function_name) {
+  for (size_t i = 0; i < sizeof(builtin_functions) / sizeof(builtin_functions[0]); i++) {
+    if (strcmp(function_name, builtin_functions[i].function_name) == 0) {
+      return &builtin_functions[i];
+    }
+  }
+  for (size_t i = 0; i < sizeof(rotated_functions) / sizeof(rotated_functions[0]); i++) {
+    if (strcmp(function_name, rotated_functions[i].function_name) == 0) {
+      return &rotated_functions[i];
+    }
+  }
+  for (size_t i = 0; i < sizeof(gallagher_functions) / sizeof(gallagher_functions[0]); i++) {
+    if (strcmp(function_name, gallagher_functions[i].function_name) == 0) {
+      return &gallagher_functions[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Returns the built-in or plugin function with the given name. Built-in functions take precedence.
+ */
+const my_plugin_function_t *find_function(const char *function_name) {
+  const my_plugin_function_t *builtin = find_builtin_function(function_name);
+  if (builtin != NULL) {
+    return builtin;
+  }
+  for (size_t i = 0; i < number_of_plugins; i++) {
+    for (size_t j = 0; j < plugins[i]->number_of_functions; j++) {
+      if (strcmp(function_name, plugins[i]->functions[j].function_name) == 0) {
+        return &plugins[i]->functions[j];
+      }
+    }
+  }
+  fprintf(stderr, "Unknown function %s.\n", function_name);
+  exit(EXIT_FAILURE);
+}
+
+/**
+ * Evaluates number_of_points decoded points of the problem, through the rotation of the population
+ * as one matrix product if the function is rotated, through the lookup table of the integer block
+ * if the problem has one (the points must then be encoded, i.e. their integer coordinates are
+ * integral and within the bounds), through the batch entry point if the function has one.
+ */
+void my_evaluate_population(const MY_PROBLEM *problem, double **x, size_t number_of_points, double *y) {
+  if (problem->rotation != NULL) {
+    my_evaluate_rotated(problem, (const double *const *)x, number_of_points, y);
+  }
+  else if (problem->integer_table != NULL) {
+    for (size_t i = 0; i < number_of_points; i++) {
+      y[i] = problem->table_evaluate(x[i], problem->dimension, problem->number_of_integer_variables, problem->optimal, problem->integer_table);
+    }
+  }
+  else if (problem->function->evaluate_batch != NULL) {
+    problem->function->evaluate_batch((const double *const *)x, number_of_points, problem->dimension, problem->optimal, y);
+  }
+  else {
+    for (size_t i = 0; i < number_of_points; i++) {
+      y[i] = problem->evaluate(x[i], problem->dimension, problem->optimal);
+    }
+  }
+}
+
+/**
+ * Evaluates one decoded point of the problem.
+ */
+double my_evaluate_point(const MY_PROBLEM *problem, const double *x) {
+  double y;
+  if (problem->rotation != NULL) {
+    my_evaluate_rotated(problem, &x, 1, &y);
+    return y;
+  }
+  return problem->evaluate(x, problem->dimension, problem->optimal);
+}
+
+/**
+ * Returns 1 if the points of the (prepared) problem can be evaluated together with the ones of
+ * other problems by my_evaluate_problems, i.e. if its function is a separable built-in function.
+ */
+int my_problem_batchable(const MY_PROBLEM *problem) {
+  const builtin_structure_t *structure = find_builtin_structure(problem->function);
+  return structure != NULL && structure->evaluate_columns != NULL && problem->rotation == NULL;
+}
+
+/**
+ * Evaluates number_of_points encoded points of batchable problems (see my_problem_batchable) of the
+ * same function, dimension and number of integer variables: point p is of problems[p]. The points
+ * go in tiles of COLUMN_TILE: the integer block of a point is looked up in the table of its problem
+ * and its continuous coordinates are shifted by the optimum of its problem into the columns of the
+ * tile, so the terms of a coordinate are one loop over the points of several problems (see
+ * builtin_structure_t). The sums are accumulated in coordinate order like in the table-driven and
+ * arithmetic variants, so every point gets the same value as from my_evaluate_population. columns
+ * is scratch of (dimension + 2) * COLUMN_TILE doubles.
+ */
+void my_evaluate_problems(const MY_PROBLEM *const *problems, double *const *x, size_t number_of_points, double *y, double *columns) {
+  const builtin_structure_t *structure = find_builtin_structure(problems[0]->function);
+  const size_t dimension = problems[0]->dimension;
+  const size_t number_of_integer_variables = problems[0]->number_of_integer_variables;
+  const size_t number_of_sums = structure->kernel->number_of_sums;
+  double *sums = columns + dimension * COLUMN_TILE;
+
+  for (size_t first = 0; first < number_of_points; first += COLUMN_TILE) {
+    const size_t count = number_of_points - first < COLUMN_TILE ? number_of_points - first : COLUMN_TILE;
+    for (size_t p = 0; p < count; p++) {
+      const MY_PROBLEM *problem = problems[first + p];
+      const double *xp = x[first + p];
+      for (size_t k = 0; k < 2; k++) {
+        sums[k * COLUMN_TILE + p] = k < number_of_sums && number_of_integer_variables > 0
+            ? integer_table_sum(xp, number_of_integer_variables, problem->integer_table, k) : 0.0;
+      }
+      for (size_t j = number_of_integer_variables; j < dimension; j++) {
+        columns[j * COLUMN_TILE + p] = xp[j] - problem->optimal[j];
+      }
+    }
+    structure->evaluate_columns(columns, sums, count, number_of_integer_variables, dimension, y + first);
+  }
+}
+
+/**
+ * Returns the state of the incremental evaluation of the trials of a DE run of the variant on the
+ * problem, or NULL if the trials are evaluated from scratch (CR of the variant > DE_DELTA_CR, where
+ * most coordinates change anyway, or the function of the problem has no delta kernel).
+ */
+de_delta_t *de_delta_new(const MY_PROBLEM *problem, const de_variant_t *variant) {
+  const builtin_structure_t *structure = find_builtin_structure(problem->function);
+  const size_t population_size = variant->population_size;
+  de_delta_t *delta;
+
+  if (variant->cr > DE_DELTA_CR || structure == NULL || structure->delta == NULL) {
+    return NULL;
+  }
+  delta = (de_delta_t *)coco_allocate_memory(sizeof(*delta));
+  delta->kernel = structure->delta;
+  delta->finalize = structure->delta_finalize;
+  delta->number_of_terms = delta->kernel->chain ? problem->dimension - 1 : problem->dimension;
+  delta->population_size = population_size;
+  delta->terms = (double**)malloc(population_size * sizeof(double*));
+  delta->trial_terms = (double**)malloc(population_size * sizeof(double*));
+  delta->affected = (size_t**)malloc(population_size * sizeof(size_t*));
+  delta->sums = (double (*)[2])malloc(population_size * sizeof(*delta->sums));
+  delta->trial_sums = (double (*)[2])malloc(population_size * sizeof(*delta->trial_sums));
+  delta->age = (size_t*)malloc(population_size * sizeof(size_t));
+  delta->trial_age = (size_t*)malloc(population_size * sizeof(size_t));
+  delta->number_of_affected = (size_t*)malloc(population_size * sizeof(size_t));
+  if (!delta->terms || !delta->trial_terms || !delta->affected || !delta->sums || !delta->trial_sums
+      || !delta->age || !delta->trial_age || !delta->number_of_affected) {
+    fprintf(stderr, "Memory allocation failed for de_delta.\n");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < population_size; i++) {
+    delta->terms[i] = coco_allocate_vector(delta->kernel->number_of_sums * delta->number_of_terms);
+    delta->trial_terms[i] = coco_allocate_vector(delta->kernel->number_of_sums * delta->number_of_terms);
+    delta->affected[i] = (size_t*)malloc(delta->number_of_terms * sizeof(size_t));
+    if (!delta->affected[i]) {
+      fprintf(stderr, "Memory allocation failed for de_delta.\n");
+      exit(EXIT_FAILURE);
+    }
+    delta->age[i] = 0;
+  }
+  return delta;
+}
 
-//   result = 0.0;
-//   for (i = 0; i < number_of_variables; ++i) {
-//     for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
-//       result += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
-//     }
-//   }
-//   result = 10.0 * pow(result / (double) (long) number_of_variables - data->f0, 3.0);
+void de_delta_free(de_delta_t *delta) {
+  for (size_t i = 0; i < delta->population_size; i++) {
+    coco_free_memory(delta->terms[i]);
+    coco_free_memory(delta->trial_terms[i]);
+    free(delta->affected[i]);
+  }
+  free(delta->terms);
+  free(delta->trial_terms);
+  free(delta->affected);
+  free(delta->sums);
+  free(delta->trial_sums);
+  free(delta->age);
+  free(delta->trial_age);
+  free(delta->number_of_affected);
+  coco_free_memory(delta);
+}
 
-//   return result;
-// }
+/**
+ * Evaluates x from scratch and stores its terms and sums. The sums are accumulated in index order,
+ * so the value is the one of problem->evaluate.
+ */
+static double de_delta_evaluate_full(const de_delta_t *delta, const MY_PROBLEM *problem, const double *x, double *terms, double *sums) {
+  const delta_kernel_t *kernel = delta->kernel;
+  const size_t number_of_terms = delta->number_of_terms;
+  double t[2];
 
-// static double f_schaffers_raw(const double *x, const size_t number_of_variables) {
+  for (size_t k = 0; k < kernel->number_of_sums; k++) {
+    sums[k] = 0.0;
+  }
+  for (size_t p = 0; p < number_of_terms; p++) {
+    kernel->terms(x, problem->optimal, p, problem->dimension, t);
+    for (size_t k = 0; k < kernel->number_of_sums; k++) {
+      terms[k * number_of_terms + p] = t[k];
+      sums[k] += t[k];
+    }
+  }
+  return delta->finalize(sums, problem->dimension);
+}
 
-//   size_t i = 0;
-//   double result;
+/**
+ * Evaluates the encoded initial population from scratch.
+ */
+void de_delta_evaluate_population(de_delta_t *delta, const MY_PROBLEM *problem, double **x, double *y) {
+  for (size_t i = 0; i < delta->population_size; i++) {
+    y[i] = de_delta_evaluate_full(delta, problem, x[i], delta->terms[i], delta->sums[i]);
+    delta->age[i] = 0;
+  }
+}
 
-//   assert(number_of_variables > 1);
+/**
+ * Evaluates the encoded trials x. Trial i differs from individual i in the coordinates the
+ * crossover took from the mutant (workspace->changed) only, so only the terms of these indices
+ * (and of their left neighbours for chain kernels) are recomputed and the sums of the individual
+ * are updated by the differences. After DE_DELTA_REFRESH incremental evaluations in a row, the
+ * trial is evaluated from scratch to bound the rounding drift of the sums.
+ */
+void de_delta_evaluate_trials(de_delta_t *delta, const MY_PROBLEM *problem, const de_workspace_t *workspace, double **x, double *y) {
+  const delta_kernel_t *kernel = delta->kernel;
+  const size_t number_of_terms = delta->number_of_terms;
+  double t[2];
+
+  for (size_t i = 0; i < delta->population_size; i++) {
+    const size_t *changed = workspace->changed[i];
+    size_t *affected = delta->affected[i];
+    size_t number_of_affected = 0;
+    double *trial_sums = delta->trial_sums[i];
+
+    if (delta->age[i] >= DE_DELTA_REFRESH) {
+      y[i] = de_delta_evaluate_full(delta, problem, x[i], delta->trial_terms[i], trial_sums);
+      delta->trial_age[i] = 0;
+      delta->number_of_affected[i] = number_of_terms;
+      for (size_t p = 0; p < number_of_terms; p++) {
+        affected[p] = p;
+      }
+      continue;
+    }
+    for (size_t c = 0; c < workspace->number_of_changed[i]; c++) {
+      size_t j = changed[c];
+      if (kernel->chain && j > 0 && (number_of_affected == 0 || affected[number_of_affected - 1] != j - 1)) {
+        affected[number_of_affected++] = j - 1;
+      }
+      if (j < number_of_terms) {
+        affected[number_of_affected++] = j;
+      }
+    }
+    for (size_t k = 0; k < kernel->number_of_sums; k++) {
+      trial_sums[k] = delta->sums[i][k];
+    }
+    for (size_t a = 0; a < number_of_affected; a++) {
+      size_t p = affected[a];
+      kernel->terms(x[i], problem->optimal, p, problem->dimension, t);
+      for (size_t k = 0; k < kernel->number_of_sums; k++) {
+        delta->trial_terms[i][k * number_of_terms + p] = t[k];
+        trial_sums[k] += t[k] - delta->terms[i][k * number_of_terms + p];
+      }
+    }
+    delta->number_of_affected[i] = number_of_affected;
+    delta->trial_age[i] = delta->age[i] + 1;
+    y[i] = delta->finalize(trial_sums, problem->dimension);
+  }
+}
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+/**
+ * Trial i replaces individual i.
+ */
+void de_delta_accept(de_delta_t *delta, size_t i) {
+  const size_t number_of_terms = delta->number_of_terms;
 
-//   /* Computation core */
-//   result = 0.0;
-//   for (i = 0; i < number_of_variables - 1; ++i) {
-//     const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
-//     if (coco_is_inf(tmp) && coco_is_nan(sin(50.0 * pow(tmp, 0.1))))  /* sin(inf) -> nan */
-//       /* the second condition is necessary to pass the integration tests under Windows and Linux */
-//       return tmp;
-//     result += pow(tmp, 0.25) * (1.0 + pow(sin(50.0 * pow(tmp, 0.1)), 2.0));
-//   }
-//   result = pow(result / ((double) (long) number_of_variables - 1.0), 2.0);
+  for (size_t a = 0; a < delta->number_of_affected[i]; a++) {
+    size_t p = delta->affected[i][a];
+    for (size_t k = 0; k < delta->kernel->number_of_sums; k++) {
+      delta->terms[i][k * number_of_terms + p] = delta->trial_terms[i][k * number_of_terms + p];
+    }
+  }
+  for (size_t k = 0; k < delta->kernel->number_of_sums; k++) {
+    delta->sums[i][k] = delta->trial_sums[i][k];
+  }
+  delta->age[i] = delta->trial_age[i];
+}
 
-//   return result;
-// }
+static void trajectory_sleep(void) {
+  struct timespec delay = {0, 1000000};
+  nanosleep(&delay, NULL);
+}
 
-// static double f_griewank_rosenbrock_raw(const double *x, const size_t number_of_variables) {
+static void trajectory_write_record(trajectory_ring_t *ring, const trajectory_record_t *record) {
+  uint64_t dimension = record->dimension;
 
-//   size_t i = 0;
-//   double tmp = 0;
-//   double result;
+  if (record->type == TRAJECTORY_BEGIN) {
+    if (ring->fp != NULL) {
+      fclose(ring->fp);
+    }
+    ring->fp = fopen(record->path, "wb");
+    if (ring->fp == NULL) {
+      fprintf(stderr, "Cannot write trajectory %s: %s\n", record->path, strerror(errno));
+      return;
+    }
+    setvbuf(ring->fp, NULL, _IOFBF, 1 << 16);
+    fwrite(TRAJECTORY_MAGIC, 1, sizeof(TRAJECTORY_MAGIC), ring->fp);
+    fwrite(&dimension, sizeof(dimension), 1, ring->fp);
+  }
+  else if (record->type == TRAJECTORY_SAMPLE && ring->fp != NULL) {
+    fwrite(&record->evaluations, sizeof(double), 1, ring->fp);
+    fwrite(&record->best_value, sizeof(double), 1, ring->fp);
+    fwrite(record->sd, sizeof(double), record->dimension, ring->fp);
+  }
+  else if (record->type == TRAJECTORY_END && ring->fp != NULL) {
+    fclose(ring->fp);
+    ring->fp = NULL;
+  }
+}
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+/**
+ * Writer thread: drains the rings until trajectory_logger_stop is called and all rings are empty.
+ */
+static void *trajectory_writer(void *arg) {
+  trajectory_logger_t *logger = (trajectory_logger_t *)arg;
+
+  while (1) {
+    int stop = __atomic_load_n(&logger->stop, __ATOMIC_ACQUIRE);
+    size_t number_of_rings = __atomic_load_n(&logger->number_of_rings, __ATOMIC_ACQUIRE);
+    size_t written = 0;
+
+    for (size_t r = 0; r < number_of_rings; r++) {
+      trajectory_ring_t *ring = logger->rings[r];
+      size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+      size_t tail = ring->tail;
+      for (; tail != head; tail++, written++) {
+        trajectory_write_record(ring, &ring->records[tail & (TRAJECTORY_RING_SIZE - 1)]);
+      }
+      __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+    if (written == 0) {
+      if (stop) {
+        break;
+      }
+      trajectory_sleep();
+    }
+  }
+  return NULL;
+}
 
-//   /* Computation core */
-//   result = 0.0;
-//   for (i = 0; i < number_of_variables - 1; ++i) {
-//     const double c1 = x[i] * x[i] - x[i + 1];
-//     const double c2 = 1.0 - x[i];
-//     tmp = 100.0 * c1 * c1 + c2 * c2;
-//     result += tmp / 4000. - cos(tmp);
-//   }
-//   result = 10. + 10. * result / (double) (number_of_variables - 1);
+void trajectory_logger_start(void) {
+  if (trajectory_logger != NULL) {
+    return;
+  }
+  trajectory_logger = (trajectory_logger_t *)coco_allocate_memory(sizeof(*trajectory_logger));
+  trajectory_logger->number_of_rings = 0;
+  trajectory_logger->stop = 0;
+  if (pthread_key_create(&trajectory_logger->ring_key, NULL) != 0
+      || pthread_mutex_init(&trajectory_logger->register_mutex, NULL) != 0
+      || pthread_create(&trajectory_logger->thread, NULL, trajectory_writer, trajectory_logger) != 0) {
+    fprintf(stderr, "Cannot start the trajectory writer thread.\n");
+    exit(EXIT_FAILURE);
+  }
+}
 
-//   return result;
-// }
+void trajectory_logger_stop(void) {
+  if (trajectory_logger == NULL) {
+    return;
+  }
+  __atomic_store_n(&trajectory_logger->stop, 1, __ATOMIC_RELEASE);
+  pthread_join(trajectory_logger->thread, NULL);
+  for (size_t r = 0; r < trajectory_logger->number_of_rings; r++) {
+    if (trajectory_logger->rings[r]->fp != NULL) {
+      fclose(trajectory_logger->rings[r]->fp);
+    }
+    coco_free_memory(trajectory_logger->rings[r]);
+  }
+  pthread_key_delete(trajectory_logger->ring_key);
+  pthread_mutex_destroy(&trajectory_logger->register_mutex);
+  coco_free_memory(trajectory_logger);
+  trajectory_logger = NULL;
+}
 
-// static double f_schwefel_raw(const double *x, const size_t number_of_variables) {
+/**
+ * Returns the ring of the calling worker, registered with the writer thread on first use.
+ */
+static trajectory_ring_t *trajectory_ring(void) {
+  trajectory_ring_t *ring = (trajectory_ring_t *)pthread_getspecific(trajectory_logger->ring_key);
 
-//   size_t i = 0;
-//   double result;
-//   double penalty, sum;
+  if (ring != NULL) {
+    return ring;
+  }
+  ring = (trajectory_ring_t *)coco_allocate_memory(sizeof(*ring));
+  ring->head = 0;
+  ring->tail = 0;
+  ring->fp = NULL;
+  pthread_mutex_lock(&trajectory_logger->register_mutex);
+  if (trajectory_logger->number_of_rings == TRAJECTORY_MAX_RINGS) {
+    fprintf(stderr, "Too many trajectory workers (at most %d).\n", TRAJECTORY_MAX_RINGS);
+    exit(EXIT_FAILURE);
+  }
+  trajectory_logger->rings[trajectory_logger->number_of_rings] = ring;
+  __atomic_store_n(&trajectory_logger->number_of_rings, trajectory_logger->number_of_rings + 1, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&trajectory_logger->register_mutex);
+  pthread_setspecific(trajectory_logger->ring_key, ring);
+  return ring;
+}
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+/**
+ * Returns the next free record of the ring of the calling worker, waiting for the writer thread
+ * if the ring is full. The record is handed over by trajectory_push.
+ */
+static trajectory_record_t *trajectory_reserve(trajectory_ring_t *ring) {
+  while (ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == TRAJECTORY_RING_SIZE) {
+    trajectory_sleep();
+  }
+  return &ring->records[ring->head & (TRAJECTORY_RING_SIZE - 1)];
+}
 
-//   /* Boundary handling*/
-//   penalty = 0.0;
-//   for (i = 0; i < number_of_variables; ++i) {
-//     const double tmp = fabs(x[i]) - 500.0;
-//     if (tmp > 0.0)
-//       penalty += tmp * tmp;
-//   }
+static void trajectory_push(trajectory_ring_t *ring) {
+  __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+}
 
-//   /* Computation core */
-//   sum = 0.0;
-//   for (i = 0; i < number_of_variables; ++i) {
-//     sum += x[i] * sin(sqrt(fabs(x[i])));
-//   }
-//   result = 0.01 * (penalty + 418.9828872724339 - sum / (double) number_of_variables);
+/**
+ * Starts the trajectory of a problem; titlestr is its result file, the trajectory is written to
+ * the same path with the extension .traj.
+ */
+void trajectory_begin(const char *titlestr, size_t dimension) {
+  trajectory_ring_t *ring;
+  trajectory_record_t *record;
+  size_t length = strlen(titlestr);
 
-//   return result;
-// }
+  if (trajectory_logger == NULL) {
+    return;
+  }
+  if (dimension > TRAJECTORY_MAX_DIMENSION || length + strlen(".traj") >= TRAJECTORY_PATH_LENGTH) {
+    fprintf(stderr, "Trajectory of %s not logged (dimension %lu).\n", titlestr, (unsigned long)dimension);
+    return;
+  }
+  if (length >= 4 && strcmp(titlestr + length - 4, ".txt") == 0) {
+    length -= 4;
+  }
+  ring = trajectory_ring();
+  record = trajectory_reserve(ring);
+  record->type = TRAJECTORY_BEGIN;
+  record->dimension = dimension;
+  memcpy(record->path, titlestr, length);
+  strcpy(record->path + length, ".traj");
+  trajectory_push(ring);
+}
 
-// static double f_gallagher_raw(const double *x, const size_t number_of_variables, f_gallagher_data_t *data) {
-//   size_t i, j; /* Loop over dim */
-//   double *tmx;
-//   double a = 0.1;
-//   double tmp2, f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
-//   double fac;
-//   double result;
+void trajectory_sample(double evaluations, double best_value, const double *sd, size_t dimension) {
+  trajectory_ring_t *ring;
+  trajectory_record_t *record;
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+  if (trajectory_logger == NULL || dimension > TRAJECTORY_MAX_DIMENSION) {
+    return;
+  }
+  ring = trajectory_ring();
+  record = trajectory_reserve(ring);
+  record->type = TRAJECTORY_SAMPLE;
+  record->dimension = dimension;
+  record->evaluations = evaluations;
+  record->best_value = best_value;
+  memcpy(record->sd, sd, dimension * sizeof(double));
+  trajectory_push(ring);
+}
 
-//   fac = -0.5 / (double) number_of_variables;
+void trajectory_end(void) {
+  trajectory_ring_t *ring;
 
-//   /* Boundary handling */
-//   for (i = 0; i < number_of_variables; ++i) {
-//     tmp = fabs(x[i]) - 5.;
-//     if (tmp > 0.) {
-//       f_pen += tmp * tmp;
-//     }
-//   }
-//   f_add = f_pen;
-//   /* Transformation in search space */
-//   /* TODO: this should rather be done in f_gallagher */
-//   tmx = coco_allocate_vector(number_of_variables);
-//   for (i = 0; i < number_of_variables; i++) {
-//     tmx[i] = 0;
-//     for (j = 0; j < number_of_variables; ++j) {
-//       tmx[i] += data->rotation[i][j] * x[j];
-//     }
-//   }
-//   /* Computation core*/
-//   for (i = 0; i < data->number_of_peaks; ++i) {
-//     tmp2 = 0.;
-//     for (j = 0; j < number_of_variables; ++j) {
-//       tmp = (tmx[j] - data->x_local[j][i]);
-//       tmp2 += data->arr_scales[i][j] * tmp * tmp;
-//     }
-//     tmp2 = data->peak_values[i] * exp(fac * tmp2);
-//     f = coco_double_max(f, tmp2);
-//   }
+  if (trajectory_logger == NULL) {
+    return;
+  }
+  ring = trajectory_ring();
+  trajectory_reserve(ring)->type = TRAJECTORY_END;
+  trajectory_push(ring);
+}
 
-//   f = 10. - f;
-//   if (f > 0) {
-//     f_true = log(f) / a;
-//     f_true = pow(exp(f_true + 0.49 * (sin(f_true) + sin(0.79 * f_true))), a);
-//   } else if (f < 0) {
-//     f_true = log(-f) / a;
-//     f_true = -pow(exp(f_true + 0.49 * (sin(0.55 * f_true) + sin(0.31 * f_true))), a);
-//   } else
-//     f_true = f;
-
-//   f_true *= f_true;
-//   f_true += f_add;
-//   result = f_true;
-//   coco_free_memory(tmx);
-//   return result;
-// }
+//TRACE
+/**
+ * Opens the trace file (see trace_header_t). The DE runs on the problems of the custom suite are
+ * then sampled (see trace_buffer_t) and every problem appends its record when it ends.
+ */
+void trace_start(const char *path) {
+  trace_header_t header;
 
-// static double f_katsuura_raw(const double *x, const size_t number_of_variables) {
+  trace_file = fopen(path, "wb");
+  if (trace_file == NULL) {
+    fprintf(stderr, "Cannot write trace %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  header.population_size = DE_N;
+  fwrite(&header, sizeof(header), 1, trace_file);
+}
 
-//   size_t i, j;
-//   double tmp, tmp2;
-//   double result;
+void trace_stop(void) {
+  if (trace_file == NULL) {
+    return;
+  }
+  if (ferror(trace_file) || fclose(trace_file) != 0) {
+    fprintf(stderr, "Cannot write trace %s.\n", trace_path);
+    exit(EXIT_FAILURE);
+  }
+  trace_file = NULL;
+}
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+static size_t trace_sample_size(size_t dimension) {
+  return 1 + DE_N * (dimension + 1);
+}
 
-//   /* Computation core */
-//   result = 1.0;
-//   for (i = 0; i < number_of_variables; ++i) {
-//     tmp = 0;
-//     for (j = 1; j < 33; ++j) {
-//       tmp2 = pow(2., (double) j);
-//       tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
-//     }
-//     tmp = 1.0 + ((double) (long) i + 1) * tmp;
-//     /*result *= tmp;*/ /* Wassim TODO: delete once consistency check passed*/
-//     result *= pow(tmp, 10. / pow((double) number_of_variables, 1.2));
-//   }
-//   /*result = 10. / ((double) number_of_variables) / ((double) number_of_variables)
-//       * (-1. + pow(result, 10. / pow((double) number_of_variables, 1.2)));*/
-//   result = 10. / ((double) number_of_variables) / ((double) number_of_variables)
-//   * (-1. + result);
+trace_buffer_t *trace_buffer_new(size_t dimension) {
+  trace_buffer_t *trace = (trace_buffer_t *)coco_allocate_memory(sizeof(*trace));
 
-//   return result;
-// }
+  trace->dimension = dimension;
+  trace->number_of_samples = 0;
+  trace->interval = 1;
+  trace->countdown = 1;
+  trace->samples = coco_allocate_vector(TRACE_MAX_SAMPLES * trace_sample_size(dimension));
+  return trace;
+}
 
-// static double f_lunacek_bi_rastrigin_raw(const double *x,
-//                                          const size_t number_of_variables,
-//                                          f_lunacek_bi_rastrigin_data_t *data) {
-//   double result;
-//   static const double condition = 100.;
-//   size_t i, j;
-//   double penalty = 0.0;
-//   static const double mu0 = 2.5;
-//   static const double d = 1.;
-//   const double s = 1. - 0.5 / (sqrt((double) (number_of_variables + 20)) - 4.1);
-//   const double mu1 = -sqrt((mu0 * mu0 - d) / s);
-//   double *tmpvect, sum1 = 0., sum2 = 0., sum3 = 0.;
+void trace_buffer_free(trace_buffer_t *trace) {
+  coco_free_memory(trace->samples);
+  coco_free_memory(trace);
+}
 
-//   assert(number_of_variables > 1);
+/**
+ * Keeps the told batch of DE_N encoded points x and their values if it is due, with the
+ * evaluations done on the problem before the batch.
+ */
+void trace_sample(trace_buffer_t *trace, double **x, const double *values, double evaluations) {
+  const size_t dimension = trace->dimension;
+  const size_t size = trace_sample_size(dimension);
+  double *sample;
 
-//   if (coco_vector_contains_nan(x, number_of_variables))
-//   	return NAN;
+  if (--trace->countdown > 0) {
+    return;
+  }
+  if (trace->number_of_samples == TRACE_MAX_SAMPLES) {
+    for (size_t k = 1; k < TRACE_MAX_SAMPLES / 2; k++) {
+      memcpy(trace->samples + k * size, trace->samples + 2 * k * size, size * sizeof(double));
+    }
+    trace->number_of_samples = TRACE_MAX_SAMPLES / 2;
+    trace->interval *= 2;
+  }
+  sample = trace->samples + trace->number_of_samples * size;
+  sample[0] = evaluations;
+  for (size_t i = 0; i < DE_N; i++) {
+    memcpy(sample + 1 + i * dimension, x[i], dimension * sizeof(double));
+  }
+  memcpy(sample + 1 + DE_N * dimension, values, DE_N * sizeof(double));
+  trace->number_of_samples++;
+  trace->countdown = trace->interval;
+}
 
-//   for (i = 0; i < number_of_variables; ++i) {
-//     double tmp;
-//     tmp = fabs(x[i]) - 5.0;
-//     if (tmp > 0.0)
-//       penalty += tmp * tmp;
-//   }
+void trace_write(const trace_buffer_t *trace, const MY_PROBLEM *problem, const de_variant_t *variant) {
+  const size_t dimension = problem->dimension;
+  trace_record_t record;
 
-//   /* x_hat */
-//   for (i = 0; i < number_of_variables; ++i) {
-//     data->x_hat[i] = 2. * x[i];
-//     if (data->xopt[i] < 0.) {
-//       data->x_hat[i] *= -1.;
-//     }
-//   }
+  if (strlen(problem->function_name) >= CATALOG_FUNCTION_NAME_LENGTH || strlen(variant->name) >= RUNTIME_VARIANT_LENGTH) {
+    fprintf(stderr, "Name %s/%s is too long for the trace.\n", problem->function_name, variant->name);
+    exit(EXIT_FAILURE);
+  }
+  memset(&record, 0, sizeof(record));
+  strcpy(record.function_name, problem->function_name);
+  strcpy(record.variant, variant->name);
+  record.r = problem->r;
+  record.number_of_integer_variables = problem->number_of_integer_variables;
+  record.dimension = dimension;
+  record.instance = problem->instance;
+  record.number_of_samples = trace->number_of_samples;
+  pthread_mutex_lock(&trace_mutex);
+  fwrite(&record, sizeof(record), 1, trace_file);
+  fwrite(problem->smallest, sizeof(double), dimension, trace_file);
+  fwrite(problem->largest, sizeof(double), dimension, trace_file);
+  fwrite(problem->optimal, sizeof(double), dimension, trace_file);
+  fwrite(trace->samples, sizeof(double), trace->number_of_samples * trace_sample_size(dimension), trace_file);
+  pthread_mutex_unlock(&trace_mutex);
+}
 
-//   tmpvect = coco_allocate_vector(number_of_variables);
-//   /* affine transformation */
-//   for (i = 0; i < number_of_variables; ++i) {
-//     double c1;
-//     tmpvect[i] = 0.0;
-//     c1 = pow(sqrt(condition), ((double) i) / (double) (number_of_variables - 1));
-//     for (j = 0; j < number_of_variables; ++j) {
-//       tmpvect[i] += c1 * data->rot2[i][j] * (data->x_hat[j] - mu0);
-//     }
-//   }
-//   for (i = 0; i < number_of_variables; ++i) {
-//     data->z[i] = 0;
-//     for (j = 0; j < number_of_variables; ++j) {
-//       data->z[i] += data->rot1[i][j] * tmpvect[j];
-//     }
-//   }
-//   /* Computation core */
-//   for (i = 0; i < number_of_variables; ++i) {
-//     sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
-//     sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
-//     sum3 += cos(2 * coco_pi * data->z[i]);
-//   }
-//   result = coco_double_min(sum1, d * (double) number_of_variables + s * sum2)
-//       + 10. * ((double) number_of_variables - sum3) + 1e4 * penalty;
-//   coco_free_memory(tmpvect);
+/**
+ * Replays the trace file at path: for every problem, the samples go REPLAY_REPEATS times through
+ * the encoding step of the traced variant and the evaluation of the problem rebuilt from its
+ * record, and the time per point of both is printed with the largest difference between the
+ * replayed values and the traced ones. The encoding step gives back the evaluated points from the
+ * points it has already encoded; the values may only differ in the last bits where the run
+ * evaluated its trials incrementally (see de_delta_t).
+ */
+void replay_trace(const char *path) {
+  FILE *fp = fopen(path, "rb");
+  trace_header_t header;
+  trace_record_t record;
+  double total_encoding = 0, total_evaluation = 0;
+  size_t total_points = 0;
+
+  if (fp == NULL) {
+    fprintf(stderr, "Cannot read trace %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  if (fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0
+      || header.population_size != DE_N) {
+    fprintf(stderr, "%s is not a trace of a DE with %d individuals.\n", path, DE_N);
+    exit(EXIT_FAILURE);
+  }
+  while (fread(&record, sizeof(record), 1, fp) == 1) {
+    const size_t dimension = (size_t)record.dimension;
+    const size_t size = trace_sample_size(dimension);
+    const de_variant_t *variant;
+    const de_kernels_t *kernels;
+    MY_PROBLEM problem;
+    double *samples, *points, values[DE_N];
+    double *encoded[DE_N], *decoded[DE_N];
+    double encoding = 0, evaluation = 0, difference = 0;
+    size_t number_of_points;
+
+    record.function_name[CATALOG_FUNCTION_NAME_LENGTH - 1] = '\0';
+    record.variant[RUNTIME_VARIANT_LENGTH - 1] = '\0';
+    variant = find_de_variant(record.variant);
+    kernels = de_select_kernels(variant, dimension);
+    memset(&problem, 0, sizeof(problem));
+    problem.function_name = (char *)malloc(strlen(record.function_name) + 1);
+    problem.smallest = (double *)malloc(dimension * sizeof(double));
+    problem.largest = (double *)malloc(dimension * sizeof(double));
+    problem.optimal = (double *)malloc(dimension * sizeof(double));
+    problem.best_solution = (double *)malloc(dimension * sizeof(double));
+    if (!problem.function_name || !problem.smallest || !problem.largest || !problem.optimal || !problem.best_solution) {
+      fprintf(stderr, "Memory allocation failed for the replayed problem.\n");
+      exit(EXIT_FAILURE);
+    }
+    strcpy(problem.function_name, record.function_name);
+    problem.r = (size_t)record.r;
+    problem.number_of_integer_variables = (size_t)record.number_of_integer_variables;
+    problem.dimension = dimension;
+    problem.instance = (size_t)record.instance;
+    problem.function = find_function(problem.function_name);
+    problem.evaluate = select_evaluate(problem.function, dimension);
+    samples = coco_allocate_vector(record.number_of_samples * size);
+    if (fread(problem.smallest, sizeof(double), dimension, fp) != dimension
+        || fread(problem.largest, sizeof(double), dimension, fp) != dimension
+        || fread(problem.optimal, sizeof(double), dimension, fp) != dimension
+        || fread(samples, sizeof(double), record.number_of_samples * size, fp) != record.number_of_samples * size) {
+      fprintf(stderr, "Trace %s is truncated.\n", path);
+      exit(EXIT_FAILURE);
+    }
+    my_problem_prepare(&problem);
+    points = coco_allocate_vector(2 * DE_N * dimension);
+    for (size_t i = 0; i < DE_N; i++) {
+      encoded[i] = points + i * dimension;
+      decoded[i] = points + (DE_N + i) * dimension;
+    }
+    for (size_t repeat = 0; repeat < REPLAY_REPEATS; repeat++) {
+      for (size_t k = 0; k < record.number_of_samples; k++) {
+        const double *sample = samples + k * size;
+        double start, encoded_time;
+        memcpy(points, sample + 1, DE_N * dimension * sizeof(double));
+        start = launcher_clock();
+        kernels->encoding_step(encoded, decoded, DE_N, dimension, problem.number_of_integer_variables, problem.largest);
+        encoded_time = launcher_clock();
+        my_evaluate_population(&problem, decoded, DE_N, values);
+        evaluation += launcher_clock() - encoded_time;
+        encoding += encoded_time - start;
+        for (size_t i = 0; repeat == 0 && i < DE_N; i++) {
+          difference = fmax(difference, fabs(values[i] - sample[1 + DE_N * dimension + i]));
+        }
+      }
+    }
+    number_of_points = REPLAY_REPEATS * (size_t)record.number_of_samples * DE_N;
+    if (number_of_points > 0) {
+      printf("%s r%lu [0,%d] %lud %s instance %lu: %lu samples, encoding %.1f ns/point, evaluation %.1f ns/point, largest difference %g\n",
+             problem.function_name, (unsigned long)problem.r, my_problem_range(&problem), (unsigned long)dimension, variant->name,
+             (unsigned long)problem.instance, (unsigned long)record.number_of_samples, 1e9 * encoding / (double)number_of_points,
+             1e9 * evaluation / (double)number_of_points, difference);
+    }
+    total_encoding += encoding;
+    total_evaluation += evaluation;
+    total_points += number_of_points;
+    coco_free_memory(points);
+    coco_free_memory(samples);
+    free_problem(&problem);
+  }
+  fclose(fp);
+  if (total_points > 0) {
+    printf("all problems: encoding %.1f ns/point, evaluation %.1f ns/point\n",
+           1e9 * total_encoding / (double)total_points, 1e9 * total_evaluation / (double)total_points);
+  }
+}
 
-//   return result;
-// }
+/**
+ * Loads a plugin (see my_plugin.h) and registers its functions for init_problem.
+ */
+void load_plugin(const char *path) {
+  void *handle;
+  const my_plugin_t *plugin;
 
-void my_evaluate_func(const double *x, double *y, const char * function_name, size_t dimension, double * optimal) {
-  if(strcmp(function_name, "f1") == 0){
-    //f1(x, y, dimension, optimal);
-    y[0] = f_sphere_raw(x, dimension, optimal) * 1;
-  }
-  else if(strcmp(function_name, "f2") == 0){
-    //f8(x, y, dimension, optimal);
-    y[0] = f_ellipsoid_raw(x, dimension, optimal) * pow(10, -3);
+  if (number_of_plugins == MAX_PLUGINS) {
+    fprintf(stderr, "Too many plugins (at most %d).\n", MAX_PLUGINS);
+    exit(EXIT_FAILURE);
   }
-  else if(strcmp(function_name, "f3") == 0){
-    //f3(x, y, dimension, optimal);
-    y[0] = f_rastrigin_raw(x, dimension, optimal) * 0.1;
+  handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (handle == NULL) {
+    fprintf(stderr, "Cannot load plugin %s: %s\n", path, dlerror());
+    exit(EXIT_FAILURE);
   }
-  else if(strcmp(function_name, "f8") == 0){
-    //f8(x, y, dimension, optimal);
-    y[0] = f_rosenbrock_raw(x, dimension, optimal) * pow(10, -2);
+  plugin = (const my_plugin_t *)dlsym(handle, MY_PLUGIN_SYMBOL);
+  if (plugin == NULL) {
+    fprintf(stderr, "Plugin %s does not export %s.\n", path, MY_PLUGIN_SYMBOL);
+    exit(EXIT_FAILURE);
   }
-  else if(strcmp(function_name, "f12") == 0){
-    //f8(x, y, dimension, optimal);
-    y[0] = f_bent_cigar_raw(x, dimension, optimal) * pow(10, -4);
+  if (plugin->abi_version != MY_PLUGIN_ABI_VERSION) {
+    fprintf(stderr, "Plugin %s has ABI version %u, expected %d.\n", path, plugin->abi_version, MY_PLUGIN_ABI_VERSION);
+    exit(EXIT_FAILURE);
   }
-  else if(strcmp(function_name, "f13") == 0){
-    //f8(x, y, dimension, optimal);
-    y[0] = f_sharp_ridge_raw(x, dimension, optimal) * 0.1;
+  for (size_t i = 0; i < plugin->number_of_functions; i++) {
+    if (plugin->functions[i].function_name == NULL || plugin->functions[i].evaluate == NULL) {
+      fprintf(stderr, "Plugin %s: function %lu has no name or no evaluate entry point.\n", path, (unsigned long)i);
+      exit(EXIT_FAILURE);
+    }
   }
-  else if(strcmp(function_name, "f14") == 0){
-    //f8(x, y, dimension, optimal);
-    y[0] = f_different_powers_raw(x, dimension, optimal) * 1;
+  plugin_handles[number_of_plugins] = handle;
+  plugins[number_of_plugins] = plugin;
+  number_of_plugins++;
+  printf("loaded plugin %s (%lu functions)\n", plugin->plugin_name, (unsigned long)plugin->number_of_functions);
+}
+
+void unload_plugins(void) {
+  while (number_of_plugins > 0) {
+    number_of_plugins--;
+    dlclose(plugin_handles[number_of_plugins]);
   }
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * Plugin interface of the custom (MY_PROBLEM) suite.
+ *
+ * A plugin is a shared object that exports a my_plugin_t object under the name MY_PLUGIN_SYMBOL.
+ * The experiment loads it with dlopen (see the --plugin=<path> option of example_experiment) and
+ * init_problem appends one MY_PROBLEM per function, integer ratio, range, dimension and instance
+ * after the built-in problems, so the built-in catalog is not affected by loading plugins.
+ *
+ * The encodings of the optimizer assume that the integer variables come first and are in [0, l]
+ * with l < 40, and that the continuous variables follow and are in [-5, 5]. Problems declaring
+ * another layout or other bounds are rejected.
+ */
+#ifndef MY_PLUGIN_H
+#define MY_PLUGIN_H
+
+#include <stddef.h>
+
+#define MY_PLUGIN_ABI_VERSION 1
+#define MY_PLUGIN_SYMBOL "my_plugin"
+
+typedef struct my_plugin_function {
+  /* Name used by the output directory tree (./output/de/<function_name>/...). */
+  const char *function_name;
+
+  /**
+   * Declares the variables of the problem with the given dimension, integer ratio r (r/5 of the
+   * variables are integer) and integer range. Sets is_integer[i] to 1 for integer variables and
+   * 0 for continuous ones and stores the bounds. Returns 0 if the problem should be generated and
+   * a non-zero value if the plugin does not support this combination.
+   * If NULL, the layout of the built-in functions is used.
+   */
+  int (*declare_variables)(size_t dimension,
+                           size_t r,
+                           double range,
+                           int *is_integer,
+                           double *lower_bounds,
+                           double *upper_bounds);
+
+  /* Returns the objective value of the decoded point x. */
+  double (*evaluate)(const double *x, size_t dimension, const double *optimal);
+
+  /**
+   * Stores the objective values of number_of_points decoded points in y. May be NULL, in which case
+   * evaluate is called for every point.
+   */
+  void (*evaluate_batch)(const double *const *x,
+                         size_t number_of_points,
+                         size_t dimension,
+                         const double *optimal,
+                         double *y);
+} my_plugin_function_t;
+
+typedef struct my_plugin {
+  unsigned int abi_version; /* must be MY_PLUGIN_ABI_VERSION */
+  const char *plugin_name;
+  size_t number_of_functions;
+  const my_plugin_function_t *functions;
+} my_plugin_t;
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * An example plugin for the custom suite: a sphere ("p1") with a scalar and a batch entry point
+ * and an l1 distance ("p2") with the built-in variable layout and a scalar entry point only.
+ *
+ * Build with "make my_plugin_example.so" and run "./example_experiment --plugin=./my_plugin_example.so".
+ */
+#include <stddef.h>
+
+#include "my_plugin.h"
+
+static int p1_declare_variables(size_t dimension, size_t r, double range, int *is_integer,
+                                double *lower_bounds, double *upper_bounds) {
+  size_t i;
+
+  for (i = 0; i < dimension; i++) {
+    if (i < dimension * r / 5) {
+      is_integer[i] = 1;
+      lower_bounds[i] = 0;
+      upper_bounds[i] = range;
+    }
+    else {
+      is_integer[i] = 0;
+      lower_bounds[i] = -5;
+      upper_bounds[i] = 5;
+    }
+  }
+  return 0;
+}
+
+static double p1_evaluate(const double *x, size_t dimension, const double *optimal) {
+  size_t i;
+  double result = 0.0;
+  double shifted_x;
+
+  for (i = 0; i < dimension; i++) {
+    shifted_x = x[i] - optimal[i];
+    result += shifted_x * shifted_x;
+  }
+  return result;
+}
+
+static void p1_evaluate_batch(const double *const *x, size_t number_of_points, size_t dimension,
+                              const double *optimal, double *y) {
+  size_t i, j;
+
+  for (j = 0; j < number_of_points; j++) {
+    y[j] = 0.0;
+  }
+  /* coordinate-major so that the inner loop runs over points */
+  for (i = 0; i < dimension; i++) {
+    for (j = 0; j < number_of_points; j++) {
+      double shifted_x = x[j][i] - optimal[i];
+      y[j] += shifted_x * shifted_x;
+    }
+  }
+}
+
+static double p2_evaluate(const double *x, size_t dimension, const double *optimal) {
+  size_t i;
+  double result = 0.0;
+  double shifted_x;
+
+  for (i = 0; i < dimension; i++) {
+    shifted_x = x[i] - optimal[i];
+    result += shifted_x < 0 ? -shifted_x : shifted_x;
+  }
+  return result;
+}
+
+static const my_plugin_function_t functions[] = {
+  {"p1", p1_declare_variables, p1_evaluate, p1_evaluate_batch},
+  {"p2", NULL, p2_evaluate, NULL}
+};
+
+const my_plugin_t my_plugin = {
+  MY_PLUGIN_ABI_VERSION,
+  "example",
+  sizeof(functions) / sizeof(functions[0]),
+  functions
+};
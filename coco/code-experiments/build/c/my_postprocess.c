@@ -0,0 +1,598 @@
+/**
+ * Post-processing of the custom suite from the runtime files of example_experiment
+ * (--runtimes=<path>), the counterpart of cocopp for the COCO suites.
+ *
+ *   my_postprocess [--bootstrap=<samples>] <prefix> <runtime file>...
+ *
+ * Reads the target hitting evaluations (first_hit, the evaluations of all restarts of the problem
+ * up to the first hit) of every problem of the given files, which usually hold one DE variant each,
+ * and writes
+ *
+ *   <prefix>_ert.txt   the expected running time to every target of every series (function, r,
+ *                      range, dimension, variant) over its instances, with a bootstrapped
+ *                      confidence interval
+ *   <prefix>_ecdf.txt  the runtime ECDF (fraction of the (problem, target) pairs hit within
+ *                      dimension * 10^x evaluations) of every variant, dimension and function
+ *                      group (every function and "all"), with a bootstrapped confidence interval
+ *
+ * and prints the area under every ECDF (the mean of the ECDF over x) with its interval, so the
+ * variants can be compared per dimension and function group. Series and groups are processed in
+ * parallel.
+ *
+ *   my_postprocess --compare <reference runtime file> <runtime file>
+ *
+ * checks instead that every problem of the reference file has the same target hitting evaluations
+ * for all targets (down to 1e-8) in the other file, e.g. a run of a changed build against one of
+ * the previous build, prints the series that differ and exits with 1 if any does (see
+ * compare_runtimes).
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "my_tools.h"
+
+#define NUMBER_OF_TARGET 51 //as in example_experiment.c
+#define RUNTIME_MAGIC "MYRUNT2"
+#define FUNCTION_NAME_LENGTH 32
+#define VARIANT_LENGTH 16
+#define DEFAULT_BOOTSTRAP 200
+#define BOOTSTRAP_SEED 0xdeadbeef
+#define CONFIDENCE_LOW 0.05
+#define CONFIDENCE_HIGH 0.95
+#define ECDF_MAX_X 4.0 //budgets up to dimension * 10^4, as the result files
+#define ECDF_STEP 0.01
+#define NUMBER_OF_POINTS 401 //ECDF_MAX_X / ECDF_STEP + 1
+
+//RUNTIME_FILE (see example_experiment.c)
+typedef struct runtime_header{
+  char magic[8];
+  uint32_t number_of_target;
+  uint32_t budget_multiplier;
+}runtime_header_t;
+
+typedef struct runtime_record{
+  char function_name[FUNCTION_NAME_LENGTH];
+  char variant[VARIANT_LENGTH];
+  uint64_t r;
+  uint64_t range;
+  uint64_t dimension;
+  uint64_t instance;
+  int64_t evaluations;
+  int32_t evaluate_result[NUMBER_OF_TARGET]; //evaluations of the best restart, for the result files
+  int32_t first_hit[NUMBER_OF_TARGET]; //evaluations of all restarts up to the first hit
+}runtime_record_t;
+
+typedef struct runtimes{
+  double target[NUMBER_OF_TARGET];
+  runtime_record_t *records;
+  size_t number_of_records;
+}runtimes_t;
+
+/* Records index[first], ..., index[first + size - 1] of a series or an ECDF group. */
+typedef struct span{
+  size_t first;
+  size_t size;
+}span_t;
+
+static size_t bootstrap_samples = DEFAULT_BOOTSTRAP;
+
+//RANDOM
+/* splitmix64; every series and group seeds its own generator, so the results do not depend on the threads. */
+static uint64_t random_next(uint64_t *state){
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static size_t random_index(uint64_t *state, size_t n){
+  return (size_t)(random_next(state) % n);
+}
+
+//READING
+static void read_runtimes(const char *path, runtimes_t *runtimes, int first){
+  runtime_header_t header;
+  double target[NUMBER_OF_TARGET];
+  size_t capacity = runtimes->number_of_records;
+  runtime_record_t record;
+  FILE *fp = fopen(path, "rb");
+
+  if(fp == NULL){
+    fprintf(stderr, "Cannot read %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  if(fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, RUNTIME_MAGIC, sizeof(RUNTIME_MAGIC)) != 0
+     || header.number_of_target != NUMBER_OF_TARGET || fread(target, sizeof(double), NUMBER_OF_TARGET, fp) != NUMBER_OF_TARGET){
+    fprintf(stderr, "%s is not a runtime file of %d targets.\n", path, NUMBER_OF_TARGET);
+    exit(EXIT_FAILURE);
+  }
+  if(first){
+    memcpy(runtimes->target, target, sizeof(target));
+  }
+  else if(memcmp(runtimes->target, target, sizeof(target)) != 0){
+    fprintf(stderr, "%s was written with other targets.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  while(fread(&record, sizeof(record), 1, fp) == 1){
+    if(runtimes->number_of_records == capacity){
+      capacity = capacity ? 2 * capacity : 16384;
+      runtimes->records = (runtime_record_t *)realloc(runtimes->records, capacity * sizeof(runtime_record_t));
+      if(runtimes->records == NULL){
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+      }
+    }
+    record.function_name[FUNCTION_NAME_LENGTH - 1] = '\0';
+    record.variant[VARIANT_LENGTH - 1] = '\0';
+    runtimes->records[runtimes->number_of_records++] = record;
+  }
+  fclose(fp);
+}
+
+static int compare_series(const runtime_record_t *a, const runtime_record_t *b){
+  int c;
+
+  if((c = strcmp(a->function_name, b->function_name)) != 0) return c;
+  if(a->r != b->r) return a->r < b->r ? -1 : 1;
+  if(a->range != b->range) return a->range < b->range ? -1 : 1;
+  if(a->dimension != b->dimension) return a->dimension < b->dimension ? -1 : 1;
+  return strcmp(a->variant, b->variant);
+}
+
+static int compare_records(const void *pa, const void *pb){
+  const runtime_record_t *a = (const runtime_record_t *)pa;
+  const runtime_record_t *b = (const runtime_record_t *)pb;
+  int c = compare_series(a, b);
+
+  if(c != 0) return c;
+  return a->instance < b->instance ? -1 : (a->instance > b->instance ? 1 : 0);
+}
+
+//ERT
+typedef struct ert_job{
+  const runtimes_t *runtimes;
+  const span_t *series;
+  double *ert; //[series][target]
+  double *low;
+  double *high;
+  size_t *successes;
+}ert_job_t;
+
+/**
+ * Expected running time of the runs run[0..n-1] to target k: the evaluations of all runs (up to
+ * the hit for successful runs) divided by the number of successful runs.
+ */
+static double expected_running_time(const runtime_record_t *const *run, size_t n, size_t k, size_t *successes){
+  double evaluations = 0;
+  size_t hits = 0;
+
+  for(size_t i = 0; i < n; i++){
+    if(run[i]->first_hit[k] != -1){
+      evaluations += run[i]->first_hit[k];
+      hits++;
+    }
+    else{
+      evaluations += (double)run[i]->evaluations;
+    }
+  }
+  if(successes != NULL){
+    *successes = hits;
+  }
+  return hits > 0 ? evaluations / (double)hits : INFINITY;
+}
+
+static void ert_series(void *arg, size_t s){
+  const ert_job_t *job = (const ert_job_t *)arg;
+  const span_t *series = &job->series[s];
+  const runtime_record_t *records = job->runtimes->records + series->first;
+  const runtime_record_t **run = (const runtime_record_t **)checked_malloc(series->size * sizeof(runtime_record_t *));
+  const runtime_record_t **resampled = (const runtime_record_t **)checked_malloc(series->size * sizeof(runtime_record_t *));
+  double *samples = (double *)checked_malloc(bootstrap_samples * sizeof(double));
+  uint64_t state = BOOTSTRAP_SEED + s;
+
+  for(size_t i = 0; i < series->size; i++){
+    run[i] = &records[i];
+  }
+  for(size_t k = 0; k < NUMBER_OF_TARGET; k++){
+    size_t index = s * NUMBER_OF_TARGET + k;
+    job->ert[index] = expected_running_time(run, series->size, k, &job->successes[index]);
+    for(size_t b = 0; b < bootstrap_samples; b++){
+      for(size_t i = 0; i < series->size; i++){
+        resampled[i] = run[random_index(&state, series->size)];
+      }
+      samples[b] = expected_running_time(resampled, series->size, k, NULL);
+    }
+    qsort(samples, bootstrap_samples, sizeof(double), compare_doubles);
+    job->low[index] = percentile(samples, bootstrap_samples, CONFIDENCE_LOW);
+    job->high[index] = percentile(samples, bootstrap_samples, CONFIDENCE_HIGH);
+  }
+  free(samples);
+  free(resampled);
+  free(run);
+}
+
+//ECDF
+typedef struct ecdf_group{
+  char function_name[FUNCTION_NAME_LENGTH]; //"all" for every function
+  char variant[VARIANT_LENGTH];
+  uint64_t dimension;
+  span_t span; //into ecdf_job_t.index
+}ecdf_group_t;
+
+typedef struct ecdf_job{
+  const runtimes_t *runtimes;
+  uint8_t *hits; //[record][point]: targets hit within dimension * 10^(point * ECDF_STEP) evaluations
+  const size_t *index;
+  const ecdf_group_t *groups;
+  double *ecdf; //[group][point]
+  double *low;
+  double *high;
+  double *area; //[group][3]: area, low, high
+}ecdf_job_t;
+
+/**
+ * Number of leading targets hit within the budget of every point, counted as in the result files.
+ */
+static void record_hits(void *arg, size_t i){
+  const ecdf_job_t *job = (const ecdf_job_t *)arg;
+  const runtime_record_t *record = &job->runtimes->records[i];
+  uint8_t *hits = job->hits + i * NUMBER_OF_POINTS;
+  size_t k = 0;
+
+  for(size_t p = 0; p < NUMBER_OF_POINTS; p++){
+    double budget = (double)record->dimension * pow(10, (double)p * ECDF_STEP);
+    while(k < NUMBER_OF_TARGET && record->first_hit[k] != -1 && (double)record->first_hit[k] <= budget){
+      k++;
+    }
+    hits[p] = (uint8_t)k;
+  }
+}
+
+/* ECDF of the records index[0..n-1] in ecdf; returns its area. */
+static double group_ecdf(const uint8_t *hits, const size_t *index, size_t n, uint32_t *sums, double *ecdf){
+  double area = 0;
+
+  memset(sums, 0, NUMBER_OF_POINTS * sizeof(uint32_t));
+  for(size_t i = 0; i < n; i++){
+    const uint8_t *row = hits + index[i] * NUMBER_OF_POINTS;
+    for(size_t p = 0; p < NUMBER_OF_POINTS; p++){
+      sums[p] += row[p];
+    }
+  }
+  for(size_t p = 0; p < NUMBER_OF_POINTS; p++){
+    ecdf[p] = sums[p] / ((double)NUMBER_OF_TARGET * (double)n);
+    area += ecdf[p];
+  }
+  return area / NUMBER_OF_POINTS;
+}
+
+static void ecdf_group(void *arg, size_t g){
+  const ecdf_job_t *job = (const ecdf_job_t *)arg;
+  const ecdf_group_t *group = &job->groups[g];
+  const size_t *index = job->index + group->span.first;
+  const size_t n = group->span.size;
+  size_t *resampled = (size_t *)checked_malloc(n * sizeof(size_t));
+  uint32_t *sums = (uint32_t *)checked_malloc(NUMBER_OF_POINTS * sizeof(uint32_t));
+  double *samples = (double *)checked_malloc(bootstrap_samples * NUMBER_OF_POINTS * sizeof(double));
+  double *areas = (double *)checked_malloc(bootstrap_samples * sizeof(double));
+  double *column = (double *)checked_malloc(bootstrap_samples * sizeof(double));
+  uint64_t state = BOOTSTRAP_SEED ^ ((uint64_t)g << 32);
+
+  job->area[3 * g] = group_ecdf(job->hits, index, n, sums, job->ecdf + g * NUMBER_OF_POINTS);
+  for(size_t b = 0; b < bootstrap_samples; b++){
+    for(size_t i = 0; i < n; i++){
+      resampled[i] = index[random_index(&state, n)];
+    }
+    areas[b] = group_ecdf(job->hits, resampled, n, sums, samples + b * NUMBER_OF_POINTS);
+  }
+  for(size_t p = 0; p < NUMBER_OF_POINTS; p++){
+    for(size_t b = 0; b < bootstrap_samples; b++){
+      column[b] = samples[b * NUMBER_OF_POINTS + p];
+    }
+    qsort(column, bootstrap_samples, sizeof(double), compare_doubles);
+    job->low[g * NUMBER_OF_POINTS + p] = percentile(column, bootstrap_samples, CONFIDENCE_LOW);
+    job->high[g * NUMBER_OF_POINTS + p] = percentile(column, bootstrap_samples, CONFIDENCE_HIGH);
+  }
+  qsort(areas, bootstrap_samples, sizeof(double), compare_doubles);
+  job->area[3 * g + 1] = percentile(areas, bootstrap_samples, CONFIDENCE_LOW);
+  job->area[3 * g + 2] = percentile(areas, bootstrap_samples, CONFIDENCE_HIGH);
+  free(column);
+  free(areas);
+  free(samples);
+  free(sums);
+  free(resampled);
+}
+
+/* Sort keys of the ECDF groups: dimension, function (all functions last), variant. */
+static const runtimes_t *sorted_runtimes;
+static int ecdf_all_functions;
+
+static int compare_group_members(const void *pa, const void *pb){
+  const runtime_record_t *a = &sorted_runtimes->records[*(const size_t *)pa];
+  const runtime_record_t *b = &sorted_runtimes->records[*(const size_t *)pb];
+  int c;
+
+  if(a->dimension != b->dimension) return a->dimension < b->dimension ? -1 : 1;
+  if(!ecdf_all_functions && (c = strcmp(a->function_name, b->function_name)) != 0) return c;
+  if((c = strcmp(a->variant, b->variant)) != 0) return c;
+  return *(const size_t *)pa < *(const size_t *)pb ? -1 : 1;
+}
+
+static int same_group(const runtime_record_t *a, const runtime_record_t *b, int all_functions){
+  return a->dimension == b->dimension && strcmp(a->variant, b->variant) == 0
+         && (all_functions || strcmp(a->function_name, b->function_name) == 0);
+}
+
+/**
+ * Appends the groups of one grouping (every function, or all functions) to groups and their records
+ * to index starting at *used.
+ */
+static size_t add_groups(const runtimes_t *runtimes, int all_functions, size_t *index, size_t *used, ecdf_group_t *groups, size_t number_of_groups){
+  size_t *members = index + *used;
+  const size_t n = runtimes->number_of_records;
+
+  for(size_t i = 0; i < n; i++){
+    members[i] = i;
+  }
+  sorted_runtimes = runtimes;
+  ecdf_all_functions = all_functions;
+  qsort(members, n, sizeof(size_t), compare_group_members);
+  for(size_t i = 0; i < n; ){
+    const runtime_record_t *first = &runtimes->records[members[i]];
+    ecdf_group_t *group = &groups[number_of_groups++];
+    size_t j = i;
+    while(j < n && same_group(first, &runtimes->records[members[j]], all_functions)){
+      j++;
+    }
+    memset(group, 0, sizeof(*group));
+    strcpy(group->function_name, all_functions ? "all" : first->function_name);
+    strcpy(group->variant, first->variant);
+    group->dimension = first->dimension;
+    group->span.first = *used + i;
+    group->span.size = j - i;
+    i = j;
+  }
+  *used += n;
+  return number_of_groups;
+}
+
+//OUTPUT
+static FILE *open_output(const char *prefix, const char *suffix){
+  char path[1024];
+  FILE *fp;
+
+  if(snprintf(path, sizeof(path), "%s%s", prefix, suffix) >= (int)sizeof(path)){
+    fprintf(stderr, "Output prefix %s is too long.\n", prefix);
+    exit(EXIT_FAILURE);
+  }
+  fp = fopen(path, "w");
+  if(fp == NULL){
+    fprintf(stderr, "Cannot write %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  return fp;
+}
+
+static void close_output(FILE *fp){
+  if(ferror(fp) || fclose(fp) != 0){
+    fprintf(stderr, "Cannot write the output.\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static void write_ert(const char *prefix, const runtimes_t *runtimes){
+  span_t *series = (span_t *)checked_malloc(runtimes->number_of_records * sizeof(span_t));
+  size_t number_of_series = 0;
+  ert_job_t job;
+  FILE *fp;
+
+  for(size_t i = 0; i < runtimes->number_of_records; ){
+    size_t j = i;
+    while(j < runtimes->number_of_records && compare_series(&runtimes->records[i], &runtimes->records[j]) == 0){
+      j++;
+    }
+    series[number_of_series].first = i;
+    series[number_of_series++].size = j - i;
+    i = j;
+  }
+  job.runtimes = runtimes;
+  job.series = series;
+  job.ert = (double *)checked_malloc(number_of_series * NUMBER_OF_TARGET * sizeof(double));
+  job.low = (double *)checked_malloc(number_of_series * NUMBER_OF_TARGET * sizeof(double));
+  job.high = (double *)checked_malloc(number_of_series * NUMBER_OF_TARGET * sizeof(double));
+  job.successes = (size_t *)checked_malloc(number_of_series * NUMBER_OF_TARGET * sizeof(size_t));
+  parallel_for(ert_series, &job, number_of_series);
+
+  fp = open_output(prefix, "_ert.txt");
+  fprintf(fp, "# function r range dimension variant target_index target instances successes ert ert_low ert_high\n");
+  for(size_t s = 0; s < number_of_series; s++){
+    const runtime_record_t *record = &runtimes->records[series[s].first];
+    for(size_t k = 0; k < NUMBER_OF_TARGET; k++){
+      size_t index = s * NUMBER_OF_TARGET + k;
+      fprintf(fp, "%s %lu %lu %lu %s %lu %.2e %lu %lu %.1f %.1f %.1f\n", record->function_name,
+              (unsigned long)record->r, (unsigned long)record->range, (unsigned long)record->dimension,
+              record->variant, (unsigned long)k, runtimes->target[k], (unsigned long)series[s].size,
+              (unsigned long)job.successes[index], job.ert[index], job.low[index], job.high[index]);
+    }
+  }
+  close_output(fp);
+  printf("%lu series\n", (unsigned long)number_of_series);
+
+  free(job.successes);
+  free(job.high);
+  free(job.low);
+  free(job.ert);
+  free(series);
+}
+
+static void write_ecdf(const char *prefix, const runtimes_t *runtimes){
+  const size_t n = runtimes->number_of_records;
+  size_t *index = (size_t *)checked_malloc(2 * n * sizeof(size_t));
+  ecdf_group_t *groups = (ecdf_group_t *)checked_malloc(2 * n * sizeof(ecdf_group_t));
+  size_t number_of_groups = 0, used = 0;
+  ecdf_job_t job;
+  FILE *fp;
+
+  number_of_groups = add_groups(runtimes, 0, index, &used, groups, number_of_groups);
+  number_of_groups = add_groups(runtimes, 1, index, &used, groups, number_of_groups);
+  job.runtimes = runtimes;
+  job.hits = (uint8_t *)checked_malloc(n * NUMBER_OF_POINTS);
+  job.index = index;
+  job.groups = groups;
+  job.ecdf = (double *)checked_malloc(number_of_groups * NUMBER_OF_POINTS * sizeof(double));
+  job.low = (double *)checked_malloc(number_of_groups * NUMBER_OF_POINTS * sizeof(double));
+  job.high = (double *)checked_malloc(number_of_groups * NUMBER_OF_POINTS * sizeof(double));
+  job.area = (double *)checked_malloc(number_of_groups * 3 * sizeof(double));
+  parallel_for(record_hits, &job, n);
+  parallel_for(ecdf_group, &job, number_of_groups);
+
+  fp = open_output(prefix, "_ecdf.txt");
+  fprintf(fp, "# function dimension variant problems x fraction low high\n");
+  for(size_t g = 0; g < number_of_groups; g++){
+    for(size_t p = 0; p < NUMBER_OF_POINTS; p++){
+      size_t k = g * NUMBER_OF_POINTS + p;
+      fprintf(fp, "%s %lu %s %lu %.2f %f %f %f\n", groups[g].function_name, (unsigned long)groups[g].dimension,
+              groups[g].variant, (unsigned long)groups[g].span.size, (double)p * ECDF_STEP, job.ecdf[k], job.low[k], job.high[k]);
+    }
+  }
+  close_output(fp);
+
+  printf("# ECDF area (mean over log10(evaluations / dimension) in [0, %.0f]) [%.0f%%, %.0f%%]\n",
+         ECDF_MAX_X, 100 * CONFIDENCE_LOW, 100 * CONFIDENCE_HIGH);
+  for(size_t g = 0; g < number_of_groups; g++){
+    printf("%-4s %4lud %-6s %.4f [%.4f, %.4f]\n", groups[g].function_name, (unsigned long)groups[g].dimension,
+           groups[g].variant, job.area[3 * g], job.area[3 * g + 1], job.area[3 * g + 2]);
+  }
+
+  free(job.area);
+  free(job.high);
+  free(job.low);
+  free(job.ecdf);
+  free(job.hits);
+  free(groups);
+  free(index);
+}
+
+//COMPARE
+/**
+ * Compares the target hitting evaluations of the problems of the runtime file path with the ones of
+ * the reference file, problem by problem (function, r, range, dimension, variant and instance).
+ * Prints every series with differing problems, with the number of (problem, target) pairs that
+ * differ, the largest target at which they first differ and the problems that hit the final target
+ * in the reference and in the file, and a summary. Returns 0 if every problem of the reference is
+ * in the file with the same evaluations for every target.
+ */
+static int compare_runtimes(const char *reference_path, const char *path){
+  runtimes_t reference, runtimes;
+  size_t j = 0, compared = 0, missing = 0, differing = 0, pairs = 0, solved[2] = {0, 0};
+
+  memset(&reference, 0, sizeof(reference));
+  memset(&runtimes, 0, sizeof(runtimes));
+  read_runtimes(reference_path, &reference, 1);
+  read_runtimes(path, &runtimes, 1);
+  if(memcmp(reference.target, runtimes.target, sizeof(reference.target)) != 0){
+    fprintf(stderr, "%s was written with other targets.\n", path);
+    exit(EXIT_FAILURE);
+  }
+  qsort(reference.records, reference.number_of_records, sizeof(runtime_record_t), compare_records);
+  qsort(runtimes.records, runtimes.number_of_records, sizeof(runtime_record_t), compare_records);
+  printf("# function r range dimension variant problems differing_problems differing_targets first_target solved_reference solved\n");
+  for(size_t i = 0; i < reference.number_of_records; ){
+    const runtime_record_t *first = &reference.records[i];
+    size_t problems = 0, differing_problems = 0, differing_targets = 0, first_target = NUMBER_OF_TARGET;
+    size_t series_solved[2] = {0, 0};
+    for(; i < reference.number_of_records && compare_series(&reference.records[i], first) == 0; i++){
+      const runtime_record_t *a = &reference.records[i];
+      size_t targets = 0;
+      int c = 1;
+      while(j < runtimes.number_of_records && (c = compare_records(&runtimes.records[j], a)) < 0){
+        j++;
+      }
+      if(c != 0){
+        missing++;
+        continue;
+      }
+      for(size_t k = 0; k < NUMBER_OF_TARGET; k++){
+        if(a->first_hit[k] != runtimes.records[j].first_hit[k]
+           || a->evaluate_result[k] != runtimes.records[j].evaluate_result[k]){
+          targets++;
+          first_target = k < first_target ? k : first_target;
+        }
+      }
+      problems++;
+      series_solved[0] += a->first_hit[NUMBER_OF_TARGET - 1] != -1;
+      series_solved[1] += runtimes.records[j].first_hit[NUMBER_OF_TARGET - 1] != -1;
+      differing_problems += targets > 0;
+      differing_targets += targets;
+      j++;
+    }
+    if(differing_problems > 0){
+      printf("%s %lu %lu %lu %s %lu %lu %lu %.2e %lu %lu\n", first->function_name, (unsigned long)first->r,
+             (unsigned long)first->range, (unsigned long)first->dimension, first->variant, (unsigned long)problems,
+             (unsigned long)differing_problems, (unsigned long)differing_targets, reference.target[first_target],
+             (unsigned long)series_solved[0], (unsigned long)series_solved[1]);
+    }
+    compared += problems;
+    solved[0] += series_solved[0];
+    solved[1] += series_solved[1];
+    differing += differing_problems;
+    pairs += differing_targets;
+  }
+  printf("%lu problems compared down to target %.2e: %lu differ in %lu (problem, target) pairs, %lu missing in %s;"
+         " final target hit by %lu in the reference, %lu in the file\n",
+         (unsigned long)compared, reference.target[NUMBER_OF_TARGET - 1], (unsigned long)differing,
+         (unsigned long)pairs, (unsigned long)missing, path, (unsigned long)solved[0], (unsigned long)solved[1]);
+  free(runtimes.records);
+  free(reference.records);
+  return differing > 0 || missing > 0;
+}
+
+int main(int argc, char **argv){
+  runtimes_t runtimes;
+  const char *prefix = NULL;
+  int number_of_files = 0;
+
+  if(argc > 1 && strcmp(argv[1], "--compare") == 0){
+    if(argc != 4){
+      fprintf(stderr, "usage: my_postprocess --compare <reference runtime file> <runtime file>\n");
+      return EXIT_FAILURE;
+    }
+    return compare_runtimes(argv[2], argv[3]) ? EXIT_FAILURE : 0;
+  }
+  memset(&runtimes, 0, sizeof(runtimes));
+  for(int i = 1; i < argc; i++){
+    if(strncmp(argv[i], "--bootstrap=", strlen("--bootstrap=")) == 0){
+      bootstrap_samples = strtoul(argv[i] + strlen("--bootstrap="), NULL, 10);
+      if(bootstrap_samples == 0){
+        fprintf(stderr, "The number of bootstrap samples must be positive.\n");
+        return EXIT_FAILURE;
+      }
+    }
+    else if(prefix == NULL){
+      prefix = argv[i];
+    }
+    else{
+      read_runtimes(argv[i], &runtimes, number_of_files++ == 0);
+    }
+  }
+  if(number_of_files == 0){
+    fprintf(stderr, "usage: my_postprocess [--bootstrap=<samples>] <prefix> <runtime file>...\n");
+    return EXIT_FAILURE;
+  }
+  if(runtimes.number_of_records == 0){
+    fprintf(stderr, "No problems in the runtime files.\n");
+    return EXIT_FAILURE;
+  }
+  qsort(runtimes.records, runtimes.number_of_records, sizeof(runtime_record_t), compare_records);
+  write_ert(prefix, &runtimes);
+  write_ecdf(prefix, &runtimes);
+  free(runtimes.records);
+  return 0;
+}
@@ -0,0 +1,488 @@
+/**
+ * Results store of the custom suite.
+ *
+ * example_experiment writes one ECDF file per problem instance,
+ * <results>/<function>/<r>/<range>/<dimension>d/<variant>-<instance>.txt, with lines
+ * "<log10(evaluations / dimension)> <number of targets hit>". This tool indexes such a tree once
+ * and answers queries on the series (function, r, range, dimension, variant) from the index:
+ *
+ *   my_results build <results> <store>      reads the tree (in parallel) into the store file
+ *   my_results query <store> <function> <r> <range> <dimension> <variant>
+ *                                           prints x, mean, 10%, 50% and 90% quantiles
+ *   my_results export <store> <results>     writes <results>/.../<dimension>d/<variant>.npy for
+ *                                           every series (in parallel)
+ *
+ * Values are fractions of the NUMBER_OF_TARGET targets, averaged over the instances (the mean
+ * column is what analysis_myclass.py computed from the text files). The .npy arrays have shape
+ * (number of x values, 5) with the columns of query. analysis_myclass.py reads a .npy only if it
+ * is newer than the text files of its series, so build and export are rerun after a campaign.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "my_tools.h"
+
+#define NUMBER_OF_TARGET 51 //as in example_experiment.c
+#define NAME_LENGTH 16
+#define PATH_LENGTH 1024
+#define STORE_MAGIC "MYRSLT1"
+#define NUMBER_OF_QUANTILES 3
+
+static const double quantiles[NUMBER_OF_QUANTILES] = {0.1, 0.5, 0.9};
+
+//STORE
+typedef struct store_header{
+  char magic[8]; //STORE_MAGIC
+  uint64_t number_of_points; //x values per ECDF
+  uint64_t number_of_series;
+}store_header_t;
+
+/* The store is the header, the x values, the series and the counts of the instances of every series. */
+typedef struct series{
+  char function_name[NAME_LENGTH];
+  char variant[NAME_LENGTH];
+  uint64_t r;
+  uint64_t range;
+  uint64_t dimension;
+  uint64_t number_of_instances;
+  uint64_t offset; //first count of the series, instance-major
+}series_t;
+
+typedef struct store{
+  store_header_t header;
+  double *x;
+  series_t *series;
+  uint8_t *counts;
+}store_t;
+
+//FILES
+typedef struct result_file{
+  char path[PATH_LENGTH];
+  char function_name[NAME_LENGTH];
+  char variant[NAME_LENGTH];
+  unsigned long r;
+  unsigned long range;
+  unsigned long dimension;
+  unsigned long instance;
+  uint8_t *counts;
+  double *x;
+  size_t number_of_points;
+}result_file_t;
+
+typedef struct file_list{
+  result_file_t *files;
+  size_t number_of_files;
+  size_t capacity;
+}file_list_t;
+
+/**
+ * Parses <function>/<r>/<range>/<dimension>d/<variant>-<instance>.txt relative to the results
+ * directory. Returns 0 on success.
+ */
+static int parse_result_path(const char *relative, result_file_t *file){
+  char function_name[PATH_LENGTH], name[PATH_LENGTH];
+  char *dash;
+  size_t length;
+
+  if(sscanf(relative, "%1023[^/]/%lu/%lu/%lud/%1023s", function_name, &file->r, &file->range, &file->dimension, name) != 5){
+    return 1;
+  }
+  length = strlen(name);
+  if(length < 4 || strcmp(name + length - 4, ".txt") != 0 || strchr(name, '/') != NULL){
+    return 1;
+  }
+  name[length - 4] = '\0';
+  dash = strrchr(name, '-');
+  if(dash == NULL || sscanf(dash + 1, "%lu", &file->instance) != 1){
+    return 1;
+  }
+  *dash = '\0';
+  if(strlen(function_name) >= NAME_LENGTH || strlen(name) >= NAME_LENGTH){
+    return 1;
+  }
+  strcpy(file->function_name, function_name);
+  strcpy(file->variant, name);
+  return 0;
+}
+
+static void collect_files(const char *root, const char *relative, file_list_t *list){
+  char path[PATH_LENGTH];
+  DIR *dir;
+  struct dirent *entry;
+  struct stat st;
+
+  snprintf(path, sizeof(path), "%s/%s", root, relative);
+  dir = opendir(path);
+  if(dir == NULL){
+    fprintf(stderr, "Cannot read %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  while((entry = readdir(dir)) != NULL){
+    char child[PATH_LENGTH];
+    if(entry->d_name[0] == '.'){
+      continue;
+    }
+    if(snprintf(child, sizeof(child), "%s%s%s", relative, relative[0] ? "/" : "", entry->d_name) >= (int)sizeof(child)
+       || snprintf(path, sizeof(path), "%s/%s", root, child) >= (int)sizeof(path)){
+      fprintf(stderr, "Path too long under %s.\n", root);
+      exit(EXIT_FAILURE);
+    }
+    if(stat(path, &st) != 0){
+      continue;
+    }
+    if(S_ISDIR(st.st_mode)){
+      collect_files(root, child, list);
+    }
+    else if(S_ISREG(st.st_mode)){
+      result_file_t file;
+      if(parse_result_path(child, &file) != 0){
+        continue;
+      }
+      strcpy(file.path, path);
+      file.counts = NULL;
+      file.x = NULL;
+      if(list->number_of_files == list->capacity){
+        list->capacity = list->capacity ? 2 * list->capacity : 1024;
+        list->files = (result_file_t *)realloc(list->files, list->capacity * sizeof(result_file_t));
+        if(list->files == NULL){
+          fprintf(stderr, "Memory allocation failed.\n");
+          exit(EXIT_FAILURE);
+        }
+      }
+      list->files[list->number_of_files++] = file;
+    }
+  }
+  closedir(dir);
+}
+
+/**
+ * Reads the whole file at once and parses it with strtod/strtol; fscanf dominated the build time.
+ */
+static void read_result_file(void *arg, size_t i){
+  result_file_t *file = &((file_list_t *)arg)->files[i];
+  size_t capacity = 4096, size;
+  char *text, *cursor, *end;
+  struct stat st;
+  FILE *fp = fopen(file->path, "rb");
+
+  if(fp == NULL || fstat(fileno(fp), &st) != 0){
+    fprintf(stderr, "Cannot read %s: %s\n", file->path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  size = (size_t)st.st_size;
+  text = (char *)checked_malloc(size + 1);
+  if(fread(text, 1, size, fp) != size){
+    fprintf(stderr, "Cannot read %s.\n", file->path);
+    exit(EXIT_FAILURE);
+  }
+  text[size] = '\0';
+  fclose(fp);
+
+  file->counts = (uint8_t *)checked_malloc(capacity);
+  file->x = (double *)checked_malloc(capacity * sizeof(double));
+  file->number_of_points = 0;
+  for(cursor = text; ; cursor = end){
+    double x = strtod(cursor, &end);
+    long count;
+    if(end == cursor){
+      break;
+    }
+    cursor = end;
+    count = strtol(cursor, &end, 10);
+    if(end == cursor){
+      break;
+    }
+    if(file->number_of_points == capacity){
+      capacity *= 2;
+      file->counts = (uint8_t *)realloc(file->counts, capacity);
+      file->x = (double *)realloc(file->x, capacity * sizeof(double));
+      if(file->counts == NULL || file->x == NULL){
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+      }
+    }
+    if(count < 0 || count > NUMBER_OF_TARGET){
+      fprintf(stderr, "%s: %ld targets hit, expected at most %d.\n", file->path, count, NUMBER_OF_TARGET);
+      exit(EXIT_FAILURE);
+    }
+    file->x[file->number_of_points] = x;
+    file->counts[file->number_of_points++] = (uint8_t)count;
+  }
+  free(text);
+}
+
+static int compare_files(const void *a, const void *b){
+  const result_file_t *fa = (const result_file_t *)a;
+  const result_file_t *fb = (const result_file_t *)b;
+  int c;
+
+  if((c = strcmp(fa->function_name, fb->function_name)) != 0) return c;
+  if(fa->r != fb->r) return fa->r < fb->r ? -1 : 1;
+  if(fa->range != fb->range) return fa->range < fb->range ? -1 : 1;
+  if(fa->dimension != fb->dimension) return fa->dimension < fb->dimension ? -1 : 1;
+  if((c = strcmp(fa->variant, fb->variant)) != 0) return c;
+  if(fa->instance != fb->instance) return fa->instance < fb->instance ? -1 : 1;
+  return 0;
+}
+
+static int same_series(const result_file_t *a, const result_file_t *b){
+  return strcmp(a->function_name, b->function_name) == 0 && strcmp(a->variant, b->variant) == 0
+         && a->r == b->r && a->range == b->range && a->dimension == b->dimension;
+}
+
+static void build_store(const char *results, const char *store_path){
+  file_list_t list = {NULL, 0, 0};
+  store_header_t header;
+  size_t number_of_points;
+  FILE *fp;
+
+  collect_files(results, "", &list);
+  if(list.number_of_files == 0){
+    fprintf(stderr, "No result files under %s.\n", results);
+    exit(EXIT_FAILURE);
+  }
+  parallel_for(read_result_file, &list, list.number_of_files);
+  qsort(list.files, list.number_of_files, sizeof(result_file_t), compare_files);
+
+  number_of_points = list.files[0].number_of_points;
+  for(size_t i = 0; i < list.number_of_files; i++){
+    if(list.files[i].number_of_points != number_of_points){
+      fprintf(stderr, "%s has %lu lines, expected %lu.\n", list.files[i].path,
+              (unsigned long)list.files[i].number_of_points, (unsigned long)number_of_points);
+      exit(EXIT_FAILURE);
+    }
+    if(memcmp(list.files[i].x, list.files[0].x, number_of_points * sizeof(double)) != 0){
+      fprintf(stderr, "%s has other x values than %s.\n", list.files[i].path, list.files[0].path);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+  header.number_of_points = number_of_points;
+  for(size_t i = 0; i < list.number_of_files; i++){
+    if(i == 0 || !same_series(&list.files[i - 1], &list.files[i])){
+      header.number_of_series++;
+    }
+  }
+
+  fp = fopen(store_path, "wb");
+  if(fp == NULL){
+    fprintf(stderr, "Cannot write %s: %s\n", store_path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  fwrite(&header, sizeof(header), 1, fp);
+  fwrite(list.files[0].x, sizeof(double), number_of_points, fp);
+  for(size_t i = 0, offset = 0; i < list.number_of_files; ){
+    series_t series;
+    size_t j = i;
+    while(j < list.number_of_files && same_series(&list.files[i], &list.files[j])){
+      j++;
+    }
+    memset(&series, 0, sizeof(series));
+    strcpy(series.function_name, list.files[i].function_name);
+    strcpy(series.variant, list.files[i].variant);
+    series.r = list.files[i].r;
+    series.range = list.files[i].range;
+    series.dimension = list.files[i].dimension;
+    series.number_of_instances = j - i;
+    series.offset = offset;
+    fwrite(&series, sizeof(series), 1, fp);
+    offset += (j - i) * number_of_points;
+    i = j;
+  }
+  for(size_t i = 0; i < list.number_of_files; i++){
+    fwrite(list.files[i].counts, 1, number_of_points, fp);
+  }
+  if(ferror(fp) || fclose(fp) != 0){
+    fprintf(stderr, "Cannot write %s.\n", store_path);
+    exit(EXIT_FAILURE);
+  }
+  printf("%lu files, %lu series, %lu points\n", (unsigned long)list.number_of_files,
+         (unsigned long)header.number_of_series, (unsigned long)number_of_points);
+
+  for(size_t i = 0; i < list.number_of_files; i++){
+    free(list.files[i].counts);
+    free(list.files[i].x);
+  }
+  free(list.files);
+}
+
+static void load_store(const char *store_path, store_t *store){
+  size_t number_of_counts = 0;
+  FILE *fp = fopen(store_path, "rb");
+
+  if(fp == NULL || fread(&store->header, sizeof(store->header), 1, fp) != 1
+     || memcmp(store->header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0){
+    fprintf(stderr, "%s is not a results store.\n", store_path);
+    exit(EXIT_FAILURE);
+  }
+  store->x = (double *)checked_malloc(store->header.number_of_points * sizeof(double));
+  store->series = (series_t *)checked_malloc(store->header.number_of_series * sizeof(series_t));
+  if(fread(store->x, sizeof(double), store->header.number_of_points, fp) != store->header.number_of_points
+     || fread(store->series, sizeof(series_t), store->header.number_of_series, fp) != store->header.number_of_series){
+    fprintf(stderr, "%s is truncated.\n", store_path);
+    exit(EXIT_FAILURE);
+  }
+  for(size_t s = 0; s < store->header.number_of_series; s++){
+    number_of_counts += store->series[s].number_of_instances * store->header.number_of_points;
+  }
+  store->counts = (uint8_t *)checked_malloc(number_of_counts);
+  if(fread(store->counts, 1, number_of_counts, fp) != number_of_counts){
+    fprintf(stderr, "%s is truncated.\n", store_path);
+    exit(EXIT_FAILURE);
+  }
+  fclose(fp);
+}
+
+static void free_store(store_t *store){
+  free(store->x);
+  free(store->series);
+  free(store->counts);
+}
+
+//AGGREGATION
+/**
+ * Fills table (number_of_points rows of x, mean and the quantiles) for one series.
+ */
+static void aggregate_series(const store_t *store, const series_t *series, double *table){
+  const size_t number_of_points = store->header.number_of_points;
+  const size_t number_of_instances = series->number_of_instances;
+  const size_t columns = 2 + NUMBER_OF_QUANTILES;
+  const uint8_t *counts = store->counts + series->offset;
+  double *values = (double *)checked_malloc(number_of_instances * sizeof(double));
+
+  for(size_t p = 0; p < number_of_points; p++){
+    double sum = 0;
+    for(size_t k = 0; k < number_of_instances; k++){
+      values[k] = counts[k * number_of_points + p] / (double)NUMBER_OF_TARGET;
+      sum += values[k];
+    }
+    qsort(values, number_of_instances, sizeof(double), compare_doubles);
+    table[p * columns] = store->x[p];
+    table[p * columns + 1] = sum / (double)number_of_instances;
+    for(size_t q = 0; q < NUMBER_OF_QUANTILES; q++){
+      table[p * columns + 2 + q] = percentile(values, number_of_instances, quantiles[q]);
+    }
+  }
+  free(values);
+}
+
+static void query_store(const char *store_path, const char *function_name, unsigned long r, unsigned long range, unsigned long dimension, const char *variant){
+  store_t store;
+  const size_t columns = 2 + NUMBER_OF_QUANTILES;
+
+  load_store(store_path, &store);
+  for(size_t s = 0; s < store.header.number_of_series; s++){
+    const series_t *series = &store.series[s];
+    if(strcmp(series->function_name, function_name) == 0 && strcmp(series->variant, variant) == 0
+       && series->r == r && series->range == range && series->dimension == dimension){
+      double *table = (double *)checked_malloc(store.header.number_of_points * columns * sizeof(double));
+      aggregate_series(&store, series, table);
+      printf("# %lu instances\n# x mean q10 q50 q90\n", (unsigned long)series->number_of_instances);
+      for(size_t p = 0; p < store.header.number_of_points; p++){
+        printf("%.3f %f %f %f %f\n", table[p * columns], table[p * columns + 1], table[p * columns + 2],
+               table[p * columns + 3], table[p * columns + 4]);
+      }
+      free(table);
+      free_store(&store);
+      return;
+    }
+  }
+  fprintf(stderr, "No series %s r=%lu range=%lu %lud %s.\n", function_name, r, range, dimension, variant);
+  exit(EXIT_FAILURE);
+}
+
+//EXPORT
+typedef struct export_job{
+  const store_t *store;
+  const char *results;
+}export_job_t;
+
+/**
+ * Writes rows x columns doubles as a .npy file (format version 1.0).
+ */
+static void write_npy(const char *path, const double *data, size_t rows, size_t columns){
+  char header[128];
+  int length = snprintf(header, sizeof(header), "{'descr': '<f8', 'fortran_order': False, 'shape': (%lu, %lu), }",
+                        (unsigned long)rows, (unsigned long)columns);
+  int padded = ((10 + length + 1 + 63) / 64) * 64 - 10; //magic, version and length take 10 bytes
+  uint16_t header_length = (uint16_t)padded;
+  unsigned char prefix[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0, 0, 0};
+  FILE *fp = fopen(path, "wb");
+
+  if(fp == NULL){
+    fprintf(stderr, "Cannot write %s: %s\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  prefix[8] = (unsigned char)(header_length & 0xff);
+  prefix[9] = (unsigned char)(header_length >> 8);
+  memset(header + length, ' ', (size_t)(padded - length - 1));
+  header[padded - 1] = '\n';
+  fwrite(prefix, 1, sizeof(prefix), fp);
+  fwrite(header, 1, (size_t)padded, fp);
+  fwrite(data, sizeof(double), rows * columns, fp);
+  if(ferror(fp) || fclose(fp) != 0){
+    fprintf(stderr, "Cannot write %s.\n", path);
+    exit(EXIT_FAILURE);
+  }
+}
+
+static void export_series(void *arg, size_t s){
+  const export_job_t *job = (const export_job_t *)arg;
+  const series_t *series = &job->store->series[s];
+  const size_t number_of_points = job->store->header.number_of_points;
+  const size_t columns = 2 + NUMBER_OF_QUANTILES;
+  double *table = (double *)checked_malloc(number_of_points * columns * sizeof(double));
+  char path[PATH_LENGTH];
+
+  aggregate_series(job->store, series, table);
+  snprintf(path, sizeof(path), "%s/%s/%lu/%lu/%lud/%s.npy", job->results, series->function_name,
+           (unsigned long)series->r, (unsigned long)series->range, (unsigned long)series->dimension, series->variant);
+  write_npy(path, table, number_of_points, columns);
+  free(table);
+}
+
+static void export_store(const char *store_path, const char *results){
+  store_t store;
+  export_job_t job;
+
+  load_store(store_path, &store);
+  job.store = &store;
+  job.results = results;
+  parallel_for(export_series, &job, store.header.number_of_series);
+  printf("%lu series exported\n", (unsigned long)store.header.number_of_series);
+  free_store(&store);
+}
+
+static void usage(void){
+  fprintf(stderr, "usage: my_results build <results> <store>\n"
+                  "       my_results query <store> <function> <r> <range> <dimension> <variant>\n"
+                  "       my_results export <store> <results>\n");
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv){
+  if(argc == 4 && strcmp(argv[1], "build") == 0){
+    build_store(argv[2], argv[3]);
+  }
+  else if(argc == 8 && strcmp(argv[1], "query") == 0){
+    query_store(argv[2], argv[3], strtoul(argv[4], NULL, 10), strtoul(argv[5], NULL, 10), strtoul(argv[6], NULL, 10), argv[7]);
+  }
+  else if(argc == 4 && strcmp(argv[1], "export") == 0){
+    export_store(argv[2], argv[3]);
+  }
+  else{
+    usage();
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * Helpers shared by the tools of the custom suite (my_results.c and my_postprocess.c): allocation
+ * that exits on failure, a parallel for over the online processors and the percentile of sorted
+ * values. The including file defines _POSIX_C_SOURCE before including this header.
+ */
+#ifndef MY_TOOLS_H
+#define MY_TOOLS_H
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define MAX_WORKERS 64
+
+static void *checked_malloc(size_t size){
+  void *p = malloc(size > 0 ? size : 1);
+  if(p == NULL){
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(EXIT_FAILURE);
+  }
+  return p;
+}
+
+//PARALLEL
+static size_t number_of_workers(void){
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if(n < 1){
+    return 1;
+  }
+  return n > MAX_WORKERS ? MAX_WORKERS : (size_t)n;
+}
+
+/**
+ * Runs work(arg, i) for i in [0, n) on number_of_workers() threads.
+ */
+typedef struct parallel_job{
+  void (*work)(void *arg, size_t i);
+  void *arg;
+  size_t n;
+  size_t next;
+}parallel_job_t;
+
+static void *parallel_worker(void *p){
+  parallel_job_t *job = (parallel_job_t *)p;
+  size_t i;
+
+  while((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->n){
+    job->work(job->arg, i);
+  }
+  return NULL;
+}
+
+static void parallel_for(void (*work)(void *arg, size_t i), void *arg, size_t n){
+  pthread_t threads[MAX_WORKERS];
+  parallel_job_t job = {work, arg, n, 0};
+  size_t workers = number_of_workers();
+
+  for(size_t t = 0; t < workers; t++){
+    if(pthread_create(&threads[t], NULL, parallel_worker, &job) != 0){
+      fprintf(stderr, "Cannot create worker thread.\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  for(size_t t = 0; t < workers; t++){
+    pthread_join(threads[t], NULL);
+  }
+}
+
+//STATISTICS
+static int compare_doubles(const void *a, const void *b){
+  double da = *(const double *)a, db = *(const double *)b;
+  return da < db ? -1 : (da > db ? 1 : 0);
+}
+
+/* Percentile of sorted values (linear interpolation, as numpy.quantile); infinite values are not interpolated. */
+static double percentile(const double *sorted, size_t n, double q){
+  double position = q * (double)(n - 1);
+  size_t below = (size_t)position;
+  if(below + 1 >= n){
+    return sorted[n - 1];
+  }
+  if(isinf(sorted[below + 1])){
+    return position == (double)below ? sorted[below] : sorted[below + 1];
+  }
+  return sorted[below] + (position - (double)below) * (sorted[below + 1] - sorted[below]);
+}
+
+#endif
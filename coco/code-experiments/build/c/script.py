@@ -1,98 +1,31 @@
 import subprocess
-from concurrent.futures import ThreadPoolExecutor
 import os
 
-# NUMAノードの設定（NUMAノード0と1にジョブを分ける）
-numa_nodes = [0, 1]
-
-# オプションの組み合わせを定義（[Lamarckian/Baldwinian, Normal/Revised]の順）
+# 実行するDEの種類（[Lamarckian/Baldwinian, Normal/Revised]の順）と出力ファイル名
 job_options = [
-    (0, 0, 0),  # DEラマルク型
-    (0, 0, 1),  # DEボールドウィン型
-    #(0, 1, 0),  # UDEラマルク型疑似round
-    #(0, 1, 1),  # UDEラマルク型middle
-    (0, 1, 2),  # UDEラマルク型best
-    (0, 1, 3),   # UDEボールドウィン型
-    #(0, 2, 0),  # U2DEラマルク型
-    #(0, 2, 1)   # U2DEボールドウィン型   
+    (0, 0, 0, "L"),     # DEラマルク型
+    (0, 0, 1, "B"),     # DEボールドウィン型
+    #(0, 1, 0, "U-Lf"),  # UDEラマルク型疑似round
+    #(0, 1, 1, "U-Lm"),  # UDEラマルク型middle
+    (0, 1, 2, "U-Lb"),  # UDEラマルク型best
+    (0, 1, 3, "U-B"),   # UDEボールドウィン型
+    #(0, 2, 0, "U2-L"),  # U2DEラマルク型
+    #(0, 2, 1, "U2-B")   # U2DEボールドウィン型
 ]
 
-# 非同期にジョブを実行するためのプロセスリスト
-processes = []
-
-def submit_job_make(i, numa_node):
-    algorithm, encoding, approach = job_options[i]
-    # ジョブスクリプトの内容を定義
-    job_script = f"""#!/bin/bash
-#PBS -N MymixintDEJob_{i}
-#PBS -l nodes=1:ppn=4:mem=16gb
-#PBS -l numactrl={numa_node}  # NUMAノードの指定
-#PBS -o ./out/output_{i}.log
-#PBS -e ./out/error_{i}.log
-
-make ALGORITHM={algorithm} ENCODING={encoding} APPROACH={approach} NUM={i}
-"""
-
-    # ジョブスクリプトを一時ファイルに保存
-    script_name = f"sh/temp_job_{i}.sh"
-    with open(script_name, "w") as file:
-        file.write(job_script)
-
-    # 実行権限を付与
-    os.chmod(script_name, 0o755)
-
-    # nohupでバックグラウンド実行
-    process = subprocess.Popen(
-        ["nohup", script_name, "&"],
-        stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True
-    )
-    processes.append(process)
-
-    # 各ジョブの結果を表示
-    for i, process in enumerate(processes):
-        stdout, stderr = process.communicate()  # 出力とエラーを取得
-        print(f"Job {i} submitted:", stdout)
-        print("Errors:", stderr)
-
-def submit_job_exe(i, numa_node):
-    # ジョブスクリプトの内容を定義
-    job_script = f"""#!/bin/bash
-#PBS -N MymixintDEJob_{i}
-#PBS -l nodes=1:ppn=4:mem=16gb
-#PBS -l numactrl={numa_node}  # NUMAノードの指定
-#PBS -o ./out/output_{i}.log
-#PBS -e ./out/error_{i}.log
-
-./example_experiment{i}
-"""
-
-    # ジョブスクリプトを一時ファイルに保存
-    script_name = f"sh/temp_job_{i}.sh"
-    with open(script_name, "w") as file:
-        file.write(job_script)
-
-    # nohupでバックグラウンド実行
-    process = subprocess.Popen(
-        ["nohup", script_name, "&"],
-        stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True
-    )
-    processes.append(process)
-
-    # 各ジョブの結果を表示
-    for i, process in enumerate(processes):
-        stdout, stderr = process.communicate()  # 出力とエラーを取得
-        print(f"Job {i} submitted:", stdout)
-        print("Errors:", stderr)
-
-# ThreadPoolExecutorで並列実行
-with ThreadPoolExecutor(max_workers=4) as executor:
-    for i in range(0,4):
-        # NUMAノードを交互に割り当て
-        numa_node = numa_nodes[i % len(numa_nodes)]
-        executor.submit(submit_job_make, i, numa_node)
-
-with ThreadPoolExecutor(max_workers=4) as executor:
-    for i in range(0,4):
-        # NUMAノードを交互に割り当て
-        numa_node = numa_nodes[i % len(numa_nodes)]
-        executor.submit(submit_job_exe, i, numa_node)
\ No newline at end of file
+# 変種は実行時に選べるので、バイナリは1つだけビルドする
+subprocess.run(["make", "ALGORITHM=0", "ENCODING=0", "APPROACH=0"], check=True)
+
+# 1プロセスで全変種を実行する。ワーカースレッドはNUMAノードに交互に固定され、
+# 各ワーカーの問題データと個体群はそのノードのメモリに置かれる（--workers=0: 使えるCPUごとに1つ）
+# 問題は前回の実行時間（out/timing.txt）から見積もった長い順に実行し、今回の時間で上書きする
+command = ["./example_experiment", "--catalog=catalog.bin", "--runtimes=output/de/runtimes.bin", "--workers=0",
+           "--timing=out/timing.txt"]
+command += ["--variant=" + name for (_, _, _, name) in job_options]
+# DEのパラメータのスイープは再ビルドせずに1プロセスで実行できる（--variantの代わりに変種:N:CR:Fの直積）
+# 結果の表はoutput/sweep.txtに書かれる。--dimensionsと--instancesで問題の一部だけを選ぶ
+#command = ["./example_experiment", "--workers=0", "--functions=f1,f3", "--dimensions=5,10", "--instances=3",
+#           "--sweep=U-Lb:50,100:0.5,0.9:0.5", "--sweep=U-B:100:0.9:0.3,0.7"]
+os.makedirs("out", exist_ok=True)
+with open("out/output.log", "w") as out, open("out/error.log", "w") as err:
+    subprocess.run(command, stdout=out, stderr=err, check=True)